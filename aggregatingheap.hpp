@@ -0,0 +1,169 @@
+#ifndef __aggregatingheap_hpp__
+#define __aggregatingheap_hpp__
+
+
+#include "fibonacciheap.hpp"
+#include <unordered_map>
+#include <functional>
+#include <utility>
+#include <iterator>
+#include <vector>
+
+/**
+ * @brief Contenitore degli elementi con la stessa chiave.
+ *
+ * I payload sono estratti nell'ordine di inserimento: front indica il primo non ancora
+ * estratto. Quando front supera metà del vettore i payload rimasti vengono spostati in
+ * un vettore nuovo, così la memoria dei payload estratti viene liberata anche se il
+ * bucket continua a ricevere inserimenti mentre è il minimo.
+ *
+ * @tparam K tipo della chiave
+ * @tparam V tipo dei payload
+*/
+template<typename K,typename V>
+struct key_bucket{
+
+    Node<K>* node; /**< nodo della Heap che rappresenta la chiave */
+    std::vector<V> payloads; /**< payload inseriti con la chiave */
+    size_t front; /**< indice del prossimo payload da estrarre */
+
+};
+
+
+
+
+/**
+ * @brief Heap con aggregazione delle chiavi uguali.
+ *
+ * Ogni chiave distinta ha un solo nodo nella fibonacci_heap; i payload inseriti con la
+ * stessa chiave vanno in un bucket associato al nodo. Inserire una chiave già presente
+ * costa quindi O(1) senza toccare la foresta, ed extract_min svuota il bucket del minimo
+ * prima di estrarne il nodo. Nodi e lavoro di consolidate dipendono solo dal numero di
+ * chiavi distinte.
+ *
+ * Le chiavi uguali per KeyEqual devono essere equivalenti anche per CMP.
+ *
+ * @tparam K tipo della chiave
+ * @tparam V tipo dei payload
+ * @tparam CMP classe del comparatore sui nodi di tipo Node<K>
+ * @tparam Hash funzione di hash delle chiavi
+ * @tparam KeyEqual uguaglianza tra chiavi
+*/
+template<typename K,typename V,typename CMP,typename Hash = std::hash<K>,typename KeyEqual = std::equal_to<K>>
+struct aggregating_fibonacci_heap{
+
+    fibonacci_heap<K,CMP> heap; /**< Heap delle chiavi distinte */
+    std::unordered_map<K,key_bucket<K,V>,Hash,KeyEqual> buckets; /**< bucket di ogni chiave presente */
+    size_t n_items; /**< numero totale di payload */
+
+    Node<K>* cached_node; /**< ultimo nodo minimo di cui si è cercato il bucket */
+    key_bucket<K,V>* cached_bucket; /**< bucket di cached_node */
+
+
+    /**
+     * @brief costruttore.
+     *
+     * Inizializza una Heap vuota
+    */
+    aggregating_fibonacci_heap()
+        : n_items(0), cached_node(nullptr), cached_bucket(nullptr)
+        {}
+
+    aggregating_fibonacci_heap(const aggregating_fibonacci_heap&) = delete;
+    aggregating_fibonacci_heap& operator=(const aggregating_fibonacci_heap&) = delete;
+
+    /**
+     * @brief distruttore.
+    */
+    ~aggregating_fibonacci_heap(){
+        this->heap.clear();
+    }
+
+
+    /**
+     * @brief numero di elementi.
+     * @return numero totale di payload nella Heap
+    */
+    size_t size() const{
+        return this->n_items;
+    }
+
+
+    /**
+     * @brief numero di chiavi distinte.
+     * @return numero di nodi nella Heap
+    */
+    size_t n_keys() const{
+        return this->heap.n_nodes;
+    }
+
+
+    /**
+     * @brief Funzione di inserimento.
+     *
+     * Se la chiave è già presente il payload si aggiunge al suo bucket, altrimenti si
+     * crea un nuovo nodo.
+     *
+     * @param key chiave
+     * @param value payload
+    */
+    void insert(const K key, V value){
+
+        typename std::unordered_map<K,key_bucket<K,V>,Hash,KeyEqual>::iterator it = this->buckets.find(key);
+
+        if(it == this->buckets.end()){
+            key_bucket<K,V> bucket;
+            bucket.node = new Node<K>(key);
+            bucket.front = 0;
+            it = this->buckets.emplace(key, std::move(bucket)).first;
+            this->heap.insert_node(it->second.node);
+        }
+
+        it->second.payloads.push_back(std::move(value));
+        this->n_items += 1;
+    }
+
+
+    /**
+     * @brief estrazione minimo.
+     *
+     * Estrae il primo payload del bucket della chiave minima; il nodo lascia la Heap
+     * solo quando il bucket è vuoto.
+     *
+     * @return coppia (chiave, payload) estratta
+    */
+    std::pair<K,V> extract_min(){
+
+        if(this->n_items == 0){
+            throw std::invalid_argument( "Can't extract min beacause the heap is empty");
+        }
+
+        if(this->cached_node != this->heap.min){    //il minimo è cambiato: si cerca il suo bucket
+            this->cached_node = this->heap.min;
+            this->cached_bucket = &this->buckets.find(this->heap.min->key)->second;
+        }
+
+        key_bucket<K,V>& bucket = *this->cached_bucket;
+        std::pair<K,V> result(bucket.node->key, std::move(bucket.payloads[bucket.front]));
+        bucket.front += 1;
+        this->n_items -= 1;
+
+        if(bucket.front == bucket.payloads.size()){     //bucket vuoto: si estrae il nodo
+            Node<K>* x = this->heap.extract_min_node();
+            this->cached_node = nullptr;
+            this->cached_bucket = nullptr;
+            this->buckets.erase(x->key);
+            delete x;
+        }
+        else if(bucket.front > bucket.payloads.size() / 2){     //compattazione: costo ammortizzato O(1)
+            std::vector<V>(std::make_move_iterator(bucket.payloads.begin() + bucket.front),
+                           std::make_move_iterator(bucket.payloads.end())).swap(bucket.payloads);
+            bucket.front = 0;
+        }
+
+        return result;
+    }
+
+};
+
+#endif  //__aggregatingheap_hpp__
@@ -0,0 +1,141 @@
+#include "kwaymerge.hpp"
+#include <queue>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+
+//Comparatore per le key dei nodi
+template<typename T>
+struct NodeComparator{
+    bool operator()(const Node<T>* n1,const Node<T>* n2){
+        return (n1->key > n2->key);
+    }
+};
+
+
+//Fusione di riferimento con std::priority_queue: per ogni elemento un pop e un push
+//della coppia (testa, cursore). Legge i cursori con gli stessi blocchi di kway_merge.
+template<typename Cursor,typename OutputIt>
+OutputIt pq_merge(std::vector<Cursor>& cursors, OutputIt out, size_t batch = 1024){
+
+    typedef typename Cursor::value_type T;
+    typedef std::pair<T,size_t> entry;
+
+    size_t k = cursors.size();
+    std::vector<T> buffers(k * batch);
+    std::vector<size_t> pos(k, 0);
+    std::vector<size_t> len(k, 0);
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> pq;
+
+    for(size_t i = 0; i < k; ++i){
+        len[i] = cursors[i].read(&buffers[i * batch], batch);
+        if(len[i] > 0){
+            pq.push(entry(buffers[i * batch], i));
+            pos[i] = 1;
+        }
+    }
+
+    while(!pq.empty()){
+        entry top = pq.top();
+        pq.pop();
+        *out = top.first;
+        ++out;
+
+        size_t i = top.second;
+        if(pos[i] == len[i]){
+            len[i] = cursors[i].read(&buffers[i * batch], batch);
+            pos[i] = 0;
+        }
+        if(len[i] > 0){
+            pq.push(entry(buffers[i * batch + pos[i]], i));
+            pos[i] += 1;
+        }
+    }
+
+    return out;
+}
+
+
+//Tempo in millisecondi di una funzione
+template<typename F>
+double time_ms(F f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+int main(int argc, char** argv){
+
+//Numero di run e lunghezza di ogni run (modificabili da riga di comando).
+//Su disco ogni fusione tiene aperti n_runs file insieme: con il limite usuale di
+//1024 descrittori (ulimit -n) si possono usare al più circa 1000 run.
+size_t n_runs = argc > 1 ? std::stoul(argv[1]) : 1000;
+size_t run_length = argc > 2 ? std::stoul(argv[2]) : 2000;
+std::string dir = argc > 3 ? argv[3] : "/tmp";
+
+std::mt19937 gen(42);
+std::vector<std::vector<int>> runs(n_runs);
+for(size_t r = 0; r < n_runs; ++r){
+    runs[r].resize(run_length);
+    for(size_t i = 0; i < run_length; ++i) runs[r][i] = (int)(gen() % 1000000000);
+    std::sort(runs[r].begin(), runs[r].end());
+}
+
+size_t total = n_runs * run_length;
+std::vector<int> out_fib(total), out_pq(total);
+
+std::cout<<"Fusione di "<<n_runs<<" run da "<<run_length<<" elementi"<<std::endl;
+
+
+//Run in memoria
+typedef range_cursor<std::vector<int>::const_iterator> mem_cursor;
+std::vector<mem_cursor> mem_a, mem_b;
+for(size_t r = 0; r < n_runs; ++r){
+    mem_a.push_back(mem_cursor(runs[r].begin(), runs[r].end()));
+    mem_b.push_back(mem_cursor(runs[r].begin(), runs[r].end()));
+}
+
+double t_fib = time_ms([&]{ kway_merge<NodeComparator<int>>(mem_a, out_fib.begin()); });
+double t_pq = time_ms([&]{ pq_merge(mem_b, out_pq.begin()); });
+
+std::cout<<"In memoria:  kway_merge "<<t_fib<<" ms, priority_queue "<<t_pq<<" ms"
+         <<(out_fib == out_pq ? "" : "  [OUTPUT DIVERSI]")<<std::endl;
+
+
+//Run su disco
+std::vector<std::string> paths;
+for(size_t r = 0; r < n_runs; ++r){
+    paths.push_back(dir + "/bench_kwaymerge_" + std::to_string(r) + ".bin");
+    std::FILE* f = std::fopen(paths[r].c_str(), "wb");
+    if(f == nullptr){
+        std::cout<<"Errore: impossibile scrivere in "<<dir<<std::endl;
+        return 1;
+    }
+    std::fwrite(runs[r].data(), sizeof(int), run_length, f);
+    std::fclose(f);
+}
+
+//I cursori di una fusione vengono chiusi prima di aprire quelli dell'altra
+{
+    std::vector<file_cursor<int>> disk;
+    for(size_t r = 0; r < n_runs; ++r) disk.push_back(file_cursor<int>(paths[r]));
+    t_fib = time_ms([&]{ kway_merge<NodeComparator<int>>(disk, out_fib.begin()); });
+}
+{
+    std::vector<file_cursor<int>> disk;
+    for(size_t r = 0; r < n_runs; ++r) disk.push_back(file_cursor<int>(paths[r]));
+    t_pq = time_ms([&]{ pq_merge(disk, out_pq.begin()); });
+}
+
+std::cout<<"Su disco:    kway_merge "<<t_fib<<" ms, priority_queue "<<t_pq<<" ms"
+         <<(out_fib == out_pq ? "" : "  [OUTPUT DIVERSI]")<<std::endl;
+
+for(size_t r = 0; r < n_runs; ++r) std::remove(paths[r].c_str());
+
+return 0;
+}
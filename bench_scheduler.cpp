@@ -0,0 +1,165 @@
+#include "scheduler.hpp"
+#include <queue>
+#include <random>
+#include <chrono>
+#include <string>
+
+
+//Pool di riferimento: una sola std::priority_queue protetta da un mutex
+struct locked_queue_pool{
+
+    struct entry{
+        long priority;
+        std::function<void()> run;
+        bool operator<(const entry& other) const{ return priority > other.priority; }
+    };
+
+    std::priority_queue<entry> queue;
+    std::mutex lock;
+    std::condition_variable wake, done;
+    size_t n_unfinished;
+    bool stopping;
+    std::vector<std::thread> threads;
+
+    locked_queue_pool(unsigned n_workers)
+        : n_unfinished(0), stopping(false)
+    {
+        for(unsigned i = 0; i < n_workers; ++i) threads.emplace_back([this]{ this->loop(); });
+    }
+
+    ~locked_queue_pool(){
+        wait();
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(size_t i = 0; i < threads.size(); ++i) threads[i].join();
+    }
+
+    void submit(long priority, std::function<void()> run){
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            queue.push(entry{priority, std::move(run)});
+            n_unfinished += 1;
+        }
+        wake.notify_one();
+    }
+
+    void wait(){
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [this]{ return n_unfinished == 0; });
+    }
+
+    void loop(){
+        while(true){
+            entry e;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [this]{ return stopping || !queue.empty(); });
+                if(queue.empty()) return;
+                e = queue.top();
+                queue.pop();
+            }
+            e.run();
+            std::lock_guard<std::mutex> guard(lock);
+            if(--n_unfinished == 0) done.notify_all();
+        }
+    }
+};
+
+
+//Lavoro sintetico di un task
+inline void spin(unsigned iterations){
+    volatile unsigned x = 0;
+    for(unsigned i = 0; i < iterations; ++i) x = x + i;
+}
+
+
+//Numero di coppie invertite di una sequenza (merge sort)
+size_t count_inversions(std::vector<long>& v, size_t lo, size_t hi, std::vector<long>& tmp){
+    if(hi - lo < 2) return 0;
+    size_t mid = (lo + hi) / 2;
+    size_t count = count_inversions(v, lo, mid, tmp) + count_inversions(v, mid, hi, tmp);
+    size_t i = lo, j = mid, k = lo;
+    while(i < mid && j < hi){
+        if(v[j] < v[i]){ count += mid - i; tmp[k++] = v[j++]; }
+        else tmp[k++] = v[i++];
+    }
+    while(i < mid) tmp[k++] = v[i++];
+    while(j < hi) tmp[k++] = v[j++];
+    for(k = lo; k < hi; ++k) v[k] = tmp[k];
+    return count;
+}
+
+
+//Esegue n task con priorità casuali: i worker vengono prima bloccati da un task "cancello"
+//ciascuno, così tutti i task sono in coda prima dell'inizio. Restituisce il tempo in ms e
+//la frazione di coppie eseguite in ordine inverso rispetto alla priorità.
+template<typename Pool>
+std::pair<double,double> run_workload(Pool& pool, unsigned n_workers, size_t n_tasks, unsigned work){
+
+    std::atomic<bool> gate(false);
+    std::atomic<unsigned> blocked(0);
+    for(unsigned i = 0; i < n_workers; ++i){
+        pool.submit(-1, [&]{ blocked += 1; while(!gate) std::this_thread::yield(); });
+    }
+    while(blocked < n_workers) std::this_thread::yield();
+
+    std::mt19937 gen(7);
+    std::vector<long> order(n_tasks);
+    std::atomic<size_t> position(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(size_t i = 0; i < n_tasks; ++i){
+        long priority = (long)(gen() % 1000000);
+        pool.submit(priority, [&order, &position, priority, work]{
+            order[position.fetch_add(1)] = priority;
+            spin(work);
+        });
+    }
+    gate = true;
+    pool.wait();
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::vector<long> tmp(n_tasks);
+    double pairs = (double)n_tasks * (n_tasks - 1) / 2;
+    double inversions = count_inversions(order, 0, n_tasks, tmp) / pairs;
+
+    return std::make_pair(std::chrono::duration<double, std::milli>(end - start).count(), inversions);
+}
+
+
+int main(int argc, char** argv){
+
+unsigned n_workers = argc > 1 ? std::stoul(argv[1]) : std::thread::hardware_concurrency();
+size_t n_tasks = argc > 2 ? std::stoul(argv[2]) : 200000;
+unsigned work = argc > 3 ? std::stoul(argv[3]) : 200;
+if(n_workers == 0) n_workers = 1;
+
+std::cout<<n_workers<<" worker, "<<n_tasks<<" task da "<<work<<" iterazioni"<<std::endl;
+
+std::pair<double,double> r;
+{
+    task_scheduler scheduler(n_workers);
+    r = run_workload(scheduler, n_workers, n_tasks, work);
+
+    size_t steals = 0, stolen = 0;
+    for(size_t i = 0; i < scheduler.workers.size(); ++i){
+        steals += scheduler.workers[i]->n_steals;
+        stolen += scheduler.workers[i]->n_stolen_tasks;
+    }
+    std::cout<<"task_scheduler:     "<<r.first<<" ms, "<<n_tasks / r.first<<" task/ms, coppie invertite "
+             <<r.second * 100<<"%, furti "<<steals<<" ("<<stolen<<" task)"<<std::endl;
+}
+{
+    locked_queue_pool pool(n_workers);
+    r = run_workload(pool, n_workers, n_tasks, work);
+    std::cout<<"locked_queue_pool:  "<<r.first<<" ms, "<<n_tasks / r.first<<" task/ms, coppie invertite "
+             <<r.second * 100<<"%"<<std::endl;
+}
+
+return 0;
+}
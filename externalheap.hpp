@@ -0,0 +1,523 @@
+#ifndef __externalheap_hpp__
+#define __externalheap_hpp__
+
+
+#include "fibonacciheap.hpp"
+#include "kwaymerge.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <algorithm>
+
+/**
+ * @brief Run ordinato su disco.
+ *
+ * Sequenza ordinata crescente di chiavi scritta su file e riletta in modo
+ * sequenziale, un blocco alla volta. La prima chiave non ancora caricata in memoria
+ * è tenuta in head.
+ *
+ * @tparam T tipo delle chiavi del run
+*/
+template<typename T>
+struct Run{
+
+    std::FILE* file; /**< file del run, letto sequenzialmente */
+    std::string path; /**< percorso del file (vuoto se è un file temporaneo anonimo) */
+    size_t remaining; /**< chiavi del run non ancora caricate, head compresa */
+    T head; /**< prima chiave non ancora caricata in memoria */
+
+};
+
+
+
+
+/**
+ * @brief Coda di priorità in memoria esterna.
+ *
+ * Mantiene in una fibonacci_heap le chiavi più piccole, entro un budget di memoria.
+ * Quando la Heap in memoria supera la capacità, la metà con le chiavi più grandi viene
+ * scritta su disco come run ordinato con I/O sequenziale. Quando la Heap in memoria si
+ * svuota, o il minimo di un run diventa più piccolo del suo minimo, si ricarica un
+ * blocco di quel run. I run sono tenuti in una piccola heap ordinata per head, e
+ * quando diventano più di max_runs i più corti vengono fusi in uno solo, così il
+ * numero di file aperti resta limitato.
+ *
+ * Il minimo della Heap in memoria può essere maggiore di qualche head (ad esempio dopo
+ * un inserimento nella Heap vuota): prima di ogni estrazione refill confronta la head
+ * minima dei run con il minimo in memoria e, se lo precede, carica un blocco di quel
+ * run. La prima chiave caricata è proprio la head minima, quindi dopo refill il minimo
+ * in memoria non è maggiore di nessuna head ed extract_min restituisce il minimo globale.
+ *
+ * Un errore di I/O lancia std::runtime_error e lascia la struttura consistente: le chiavi
+ * di un run non scritto per intero restano in memoria, i run sorgente di una fusione
+ * fallita restano invariati e i file parziali vengono rimossi.
+ *
+ * @tparam T tipo delle chiavi (deve essere banalmente copiabile per essere scritto su disco)
+ * @tparam CMP classe del comparatore (lo stesso della fibonacci_heap)
+*/
+template<typename T,typename CMP>
+struct external_fibonacci_heap{
+
+    static_assert(std::is_trivially_copyable<T>::value, "external_fibonacci_heap richiede chiavi banalmente copiabili");
+
+    fibonacci_heap<T,CMP> heap; /**< Heap in memoria con le chiavi più piccole */
+    std::vector<Run<T>> runs; /**< run su disco non ancora esauriti, in una heap binaria per head */
+    std::string dir; /**< directory dei run (vuota: file temporanei di sistema) */
+    size_t capacity; /**< numero massimo di nodi nella Heap in memoria */
+    size_t block; /**< numero di chiavi lette o scritte per ogni operazione di I/O */
+    size_t n_disk; /**< numero di chiavi presenti solo su disco */
+    size_t max_runs; /**< numero massimo di run aperti prima di una fusione */
+    size_t n_files; /**< file di run creati, per dare a ognuno un nome distinto */
+
+    size_t bytes_written; /**< byte scritti su disco */
+    size_t bytes_read; /**< byte letti da disco */
+    size_t n_spills; /**< numero di run scritti su disco */
+    size_t n_refills; /**< numero di blocchi ricaricati da disco */
+    size_t n_merges; /**< numero di fusioni di run */
+
+
+    /**
+     * @brief costruttore.
+     *
+     * Il budget comprende i nodi della Heap in memoria e il blocco di lettura;
+     * la capacità della Heap è quindi (memory_budget - block_bytes)/sizeof(Node<T>).
+     *
+     * @param memory_budget budget di memoria in byte
+     * @param block_bytes dimensione in byte di un blocco di I/O
+     * @param run_dir directory in cui scrivere i run (vuota per usare tmpfile())
+     * @param max_open_runs numero massimo di run aperti (almeno 2)
+    */
+    external_fibonacci_heap(size_t memory_budget, size_t block_bytes = 64*1024, const std::string& run_dir = "",
+                            size_t max_open_runs = 64)
+        : dir(run_dir), n_disk(0), max_runs(max_open_runs), n_files(0),
+          bytes_written(0), bytes_read(0), n_spills(0), n_refills(0), n_merges(0)
+    {
+        this->block = block_bytes / sizeof(T);
+        if(this->block == 0) this->block = 1;
+
+        size_t heap_bytes = memory_budget > block_bytes ? memory_budget - block_bytes : 0;
+        this->capacity = heap_bytes / sizeof(Node<T>);
+        if(this->capacity < 2) this->capacity = 2;     //Servono almeno due nodi per dividere a metà
+        if(this->max_runs < 2) this->max_runs = 2;     //Una fusione deve lasciare meno run di prima
+    }
+
+    external_fibonacci_heap(const external_fibonacci_heap&) = delete;
+    external_fibonacci_heap& operator=(const external_fibonacci_heap&) = delete;
+
+    /**
+     * @brief distruttore.
+     *
+     * Chiude e rimuove i run ancora aperti e libera i nodi in memoria.
+    */
+    ~external_fibonacci_heap(){
+        for(size_t i = 0; i < this->runs.size(); ++i) this->close_run(this->runs[i]);
+        this->heap.clear();
+    }
+
+
+    /**
+     * @brief numero di chiavi.
+     * @return numero totale di chiavi, in memoria e su disco
+    */
+    size_t size() const{
+        return this->heap.n_nodes + this->n_disk;
+    }
+
+
+    /**
+     * @brief Funzione di inserimento.
+     *
+     * La chiave entra sempre nella Heap in memoria; se questa è già piena si scrive
+     * prima su disco la metà con le chiavi più grandi.
+     *
+     * @param x valore da inserire
+    */
+    void insert(const T x){
+
+        if(this->heap.n_nodes >= this->capacity) this->spill();
+
+        this->heap.insert(x);
+    }
+
+
+    /**
+     * @brief estrazione minimo.
+     *
+     * Prima di estrarre ricarica, se necessario, un blocco dal run con la head minima.
+     *
+     * @return valore minimo estratto
+    */
+    T extract_min(){
+
+        if(this->size()==0){
+            throw std::invalid_argument( "Can't extract min beacause the heap is empty");   //Errore: viene lanciato se la heap è vuota
+        }
+
+        this->refill();
+        return this->heap.extract_min();
+    }
+
+
+private:
+
+    /**
+     * @brief ordine dei run.
+     *
+     * Comparatore per std::push_heap e std::pop_heap: il run con la head minima sta
+     * in cima alla heap.
+    */
+    struct run_order{
+
+        external_fibonacci_heap* owner;
+
+        run_order(external_fibonacci_heap* o)
+            : owner(o)
+            {}
+
+        bool operator()(const Run<T>& a, const Run<T>& b) const{
+            return this->owner->less(b.head, a.head);
+        }
+    };
+
+
+    /**
+     * @brief cursore di lettura di un run, per kway_merge.
+    */
+    struct run_cursor{
+
+        typedef T value_type;
+
+        external_fibonacci_heap* owner;
+        Run<T>* run;
+
+        run_cursor(external_fibonacci_heap* o, Run<T>* r)
+            : owner(o), run(r)
+            {}
+
+        size_t read(T* out, size_t max){
+            return this->owner->read_block(*this->run, out, max);
+        }
+    };
+
+
+    /**
+     * @brief iteratore di output che scrive su un run, un buffer alla volta.
+    */
+    struct run_writer{
+
+        external_fibonacci_heap* owner;
+        Run<T>* run;
+        std::vector<T> buffer;
+        size_t count;
+
+        run_writer(external_fibonacci_heap* o, Run<T>* r, size_t size)
+            : owner(o), run(r), buffer(size), count(0)
+            {}
+
+        run_writer& operator*(){ return *this; }
+        run_writer& operator++(){ return *this; }
+
+        run_writer& operator=(const T& x){
+            this->buffer[this->count++] = x;
+            if(this->count == this->buffer.size()) this->flush();
+            return *this;
+        }
+
+        void flush(){
+            this->owner->write_block(*this->run, &this->buffer[0], this->count);
+            this->count = 0;
+        }
+    };
+
+
+    /**
+     * @brief confronto tra chiavi.
+     *
+     * Il comparatore lavora su puntatori a nodi, quindi le chiavi vengono confrontate
+     * attraverso due nodi di appoggio.
+     *
+     * @return true se a precede strettamente b
+    */
+    bool less(const T& a, const T& b){
+        Node<T> na(a);
+        Node<T> nb(b);
+        return this->heap.cmp(&nb, &na);
+    }
+
+
+    /**
+     * @brief scrittura su disco.
+     *
+     * Estrae in ordine i nodi della metà più piccola e li sposta in una nuova Heap
+     * senza copiarli; le chiavi della metà più grande escono già ordinate e vengono
+     * scritte come nuovo run, un blocco alla volta. Oltre ai nodi serve quindi solo
+     * il buffer di un blocco. I nodi scritti vengono liberati solo a run completo: se
+     * la scrittura fallisce tornano nella Heap e il file parziale viene rimosso.
+    */
+    void spill(){
+
+        Run<T> run;
+        run.file = this->open_run(run.path);
+
+        size_t keep = this->heap.n_nodes / 2;
+
+        fibonacci_heap<T,CMP> kept;
+        kept.cmp = this->heap.cmp;
+        for(size_t i = 0; i < keep; ++i) kept.insert_node(this->heap.extract_min_node());
+        run.remaining = this->heap.n_nodes;
+
+        fibonacci_heap<T,CMP> written;      //nodi già scritti, liberati solo a run completo
+        written.cmp = this->heap.cmp;
+
+        try{
+            std::vector<T> buffer(std::min(this->block, this->heap.n_nodes));
+            while(this->heap.n_nodes > 0){
+
+                size_t count = 0;
+                while(count < buffer.size() && this->heap.n_nodes > 0){
+                    Node<T>* x = this->heap.extract_min_node();
+                    buffer[count++] = x->key;
+                    written.insert_node(x);
+                }
+                this->write_block(run, &buffer[0], count);
+            }
+            this->start_run(run);
+        }
+        catch(...){     //le chiavi tornano in memoria e il file parziale viene rimosso
+            this->close_run(run);
+            this->heap.heap_union(written);
+            this->heap.heap_union(kept);
+            throw;
+        }
+
+        written.clear();
+        this->heap.heap_union(kept);    //la Heap è vuota: riprende i nodi tenuti in memoria
+
+        this->bytes_written += run.remaining * sizeof(T);
+        this->n_disk += run.remaining;
+        this->n_spills += 1;
+        this->runs.push_back(run);
+        std::push_heap(this->runs.begin(), this->runs.end(), run_order(this));
+
+        if(this->runs.size() > this->max_runs) this->merge_runs();
+    }
+
+
+    /**
+     * @brief ricarica da disco.
+     *
+     * Se la Heap in memoria è vuota, o la head minima dei run precede il suo minimo,
+     * carica in memoria un blocco del run con la head minima. Il blocco non supera
+     * lo spazio libero nella Heap; se la Heap è piena si fa prima spazio con spill.
+     * La prima chiave del blocco è la head minima, quindi dopo un solo blocco il minimo
+     * in memoria non è maggiore di nessuna head (le altre chiavi del blocco possono
+     * esserlo, ma non serve).
+    */
+    void refill(){
+
+        if(this->runs.empty()) return;
+        if(this->heap.n_nodes > 0 && !this->less(this->runs.front().head, this->heap.min->key)) return;
+
+        if(this->heap.n_nodes >= this->capacity) this->spill();    //il nuovo run non cambia la head minima
+
+        std::pop_heap(this->runs.begin(), this->runs.end(), run_order(this));     //il run con la head minima va in fondo
+        Run<T>& run = this->runs.back();
+
+        std::vector<T> buffer(std::min(std::min(this->block, run.remaining), this->capacity - this->heap.n_nodes));
+        size_t count = 0;
+        try{
+            count = this->read_block(run, &buffer[0], buffer.size());
+        }
+        catch(...){     //il run è invariato: torna al suo posto nella heap dei run
+            std::push_heap(this->runs.begin(), this->runs.end(), run_order(this));
+            throw;
+        }
+
+        for(size_t i = 0; i < count; ++i) this->heap.insert(buffer[i]);
+        this->n_disk -= count;
+        this->n_refills += 1;
+
+        if(run.remaining > 0){
+            std::push_heap(this->runs.begin(), this->runs.end(), run_order(this));
+        }
+        else{   //run esaurito: lo si chiude
+            this->close_run(run);
+            this->runs.pop_back();
+        }
+    }
+
+
+    /**
+     * @brief fusione di run.
+     *
+     * Fonde con kway_merge i run più corti in un unico run, finchè ne restano
+     * max_runs/2 + 1. Fondendo sempre i più corti la lunghezza dei run cresce in modo
+     * geometrico, quindi ogni chiave viene riscritta poche volte. I buffer di lettura
+     * dei run fusi e quello di scrittura si dividono un solo blocco.
+    */
+    void merge_runs(){
+
+        std::vector<size_t> order(this->runs.size());      //indici dei run dal più corto
+        for(size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::sort(order.begin(), order.end(),
+                  [this](size_t a, size_t b){ return this->runs[a].remaining < this->runs[b].remaining; });
+
+        size_t m = this->runs.size() - this->max_runs / 2;     //run da fondere
+        std::vector<bool> merging(this->runs.size(), false);
+
+        Run<T> merged;
+        merged.remaining = 0;
+        std::vector<run_cursor> cursors;
+        std::vector<Run<T>> saved;      //stato dei run sorgente, ripristinato se la fusione fallisce
+        std::vector<long> offsets;
+        for(size_t i = 0; i < m; ++i){
+            Run<T>& source = this->runs[order[i]];
+            merging[order[i]] = true;
+            cursors.push_back(run_cursor(this, &source));
+            saved.push_back(source);
+            offsets.push_back(std::ftell(source.file));
+            merged.remaining += source.remaining;
+        }
+
+        merged.file = this->open_run(merged.path);
+
+        try{
+            size_t batch = std::max<size_t>(1, this->block / (m + 1));
+            run_writer out = kway_merge<CMP>(cursors, run_writer(this, &merged, batch), batch);
+            out.flush();
+            this->start_run(merged);
+        }
+        catch(...){
+            this->close_run(merged);
+            for(size_t i = 0; i < m; ++i){
+                Run<T>& source = this->runs[order[i]];
+                source = saved[i];
+                std::clearerr(source.file);
+                std::fseek(source.file, offsets[i], SEEK_SET);
+            }
+            throw;
+        }
+
+        std::vector<Run<T>> rest;       //run non fusi, nello stesso ordine: sono ancora una heap
+        for(size_t i = 0; i < this->runs.size(); ++i){
+            if(merging[i]) this->close_run(this->runs[i]);
+            else rest.push_back(this->runs[i]);
+        }
+        this->runs.swap(rest);
+        std::make_heap(this->runs.begin(), this->runs.end(), run_order(this));
+
+        this->bytes_written += merged.remaining * sizeof(T);
+        this->n_merges += 1;
+        this->runs.push_back(merged);
+        std::push_heap(this->runs.begin(), this->runs.end(), run_order(this));
+    }
+
+
+    /**
+     * @brief lettura di un blocco da un run.
+     *
+     * Il blocco inizia dalla head; se il run non è finito viene letta anche la head
+     * successiva. Se una lettura fallisce il run resta com'era.
+     *
+     * @param run run da leggere
+     * @param out buffer in cui copiare le chiavi
+     * @param max numero massimo di chiavi da leggere
+     * @return numero di chiavi lette (0 se il run è finito)
+    */
+    size_t read_block(Run<T>& run, T* out, size_t max){
+
+        size_t count = std::min(max, run.remaining);
+        if(count == 0) return 0;
+
+        long offset = std::ftell(run.file);
+        T next = run.head;
+
+        bool ok = count == 1 || std::fread(out + 1, sizeof(T), count - 1, run.file) == count - 1;
+        if(ok && run.remaining > count) ok = std::fread(&next, sizeof(T), 1, run.file) == 1;
+        if(!ok){
+            std::clearerr(run.file);
+            std::fseek(run.file, offset, SEEK_SET);
+            throw std::runtime_error("Can't read run from disk");
+        }
+
+        out[0] = run.head;
+        run.head = next;
+        run.remaining -= count;
+        this->bytes_read += (run.remaining > 0 ? count : count - 1) * sizeof(T);
+        return count;
+    }
+
+
+    /**
+     * @brief scrittura di un blocco su un run.
+     *
+     * Ogni blocco viene scaricato con fflush, così un errore (ad esempio disco pieno)
+     * emerge qui e non alla rilettura del run.
+     *
+     * @param run run in scrittura
+     * @param data chiavi da scrivere
+     * @param count numero di chiavi
+    */
+    void write_block(Run<T>& run, const T* data, size_t count){
+
+        if(count == 0) return;
+        if(std::fwrite(data, sizeof(T), count, run.file) != count || std::fflush(run.file) != 0){
+            throw std::runtime_error("Can't write run to disk");
+        }
+    }
+
+
+    /**
+     * @brief inizio della lettura di un run scritto.
+     *
+     * Riporta il file all'inizio e ne legge la head.
+     *
+     * @param run run appena scritto per intero
+    */
+    void start_run(Run<T>& run){
+
+        std::rewind(run.file);
+        if(std::fread(&run.head, sizeof(T), 1, run.file) != 1){
+            throw std::runtime_error("Can't read run from disk");
+        }
+        this->bytes_read += sizeof(T);
+    }
+
+
+    /**
+     * @brief apertura di un nuovo run.
+     * @param path percorso del file creato (vuoto se anonimo)
+     * @return file aperto in lettura e scrittura
+    */
+    std::FILE* open_run(std::string& path){
+
+        std::FILE* file = nullptr;
+
+        if(this->dir.empty()){
+            path.clear();
+            file = std::tmpfile();
+        }
+        else{
+            path = this->dir + "/fibheap_run_" + std::to_string((size_t)this) + "_" + std::to_string(this->n_files) + ".bin";
+            file = std::fopen(path.c_str(), "w+b");
+        }
+
+        if(file == nullptr) throw std::runtime_error("Can't create run file");
+        this->n_files += 1;
+        return file;
+    }
+
+
+    /**
+     * @brief chiusura di un run.
+     * @param run run da chiudere e rimuovere da disco
+    */
+    void close_run(Run<T>& run){
+        std::fclose(run.file);
+        if(!run.path.empty()) std::remove(run.path.c_str());
+    }
+
+};
+
+#endif  //__externalheap_hpp__
@@ -4,6 +4,11 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <vector>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
 
 /**
  * @brief Struct di un nodo.
@@ -25,15 +30,24 @@ struct Node{
     
     int degree; /** < numero di figli del nodo */
     bool mark; /** < vale 1 se il nodo è marcato, 0 altrimenti */
+    bool pooled; /** < vale 1 se il nodo appartiene a un'arena della Heap e non va liberato con delete */
 
 
     /**
      * @brief costruttore.
      * 
-     * Imposta come valore della chiave 0
+     * Imposta come valore della chiave quello di default (0 per i tipi numerici)
     */
     Node()
-    : key(0),child(nullptr),left(nullptr),right(nullptr),parent(nullptr),degree(0),mark(false)
+    : key(),child(nullptr),left(nullptr),right(nullptr),parent(nullptr),degree(0),mark(false),pooled(false)
+    {}
+
+    /**
+     * @brief costruttore con chiave.
+     * @param k valore della chiave
+    */
+    explicit Node(const T& k)
+    : key(k),child(nullptr),left(nullptr),right(nullptr),parent(nullptr),degree(0),mark(false),pooled(false)
     {}
 
 };
@@ -55,6 +69,11 @@ struct fibonacci_heap{
     size_t n_nodes; /**< numero di nodi nella Heap */
     size_t n_tree; /**< numero di alberi nella Heap */
     CMP cmp; /**< comparatore */
+    std::vector<Node<T>*> arenas; /**< blocchi di nodi allocati in un'unica volta, liberati da clear */
+
+    size_t consolidate_budget; /**< radici consolidate al più per operazione (0: consolidazione completa) */
+    size_t n_pending; /**< radici in testa alla lista non ancora consolidate (modalità incrementale) */
+    std::vector<Node<T>*> degree_table; /**< radici consolidate indicizzate per degree (modalità incrementale) */
 
 
     /**
@@ -63,7 +82,7 @@ struct fibonacci_heap{
      * Inizializza una Heap vuota
     */
     fibonacci_heap()
-        : head(nullptr), min(nullptr), n_nodes(0), n_tree(0)
+        : head(nullptr), min(nullptr), n_nodes(0), n_tree(0), consolidate_budget(0), n_pending(0)
         {}
 
     
@@ -77,7 +96,20 @@ struct fibonacci_heap{
 
         Node<T>* X = new Node<T>;
         X->key = x;
-        
+        this->insert_node(X);
+    }
+
+
+
+    /**
+     * @brief Funzione di inserimento di un nodo.
+     * 
+     * Aggiunge alla lista di radici un nodo già allocato e staccato da ogni altra Heap
+     * (ad esempio restituito da extract_min_node), senza nuove allocazioni.
+     * 
+     * @param X nodo da inserire
+    */
+    void insert_node(Node<T>* X){
 
         //inserimento su una heap ancora vuota       
         if (this->n_nodes==0){
@@ -115,8 +147,42 @@ struct fibonacci_heap{
         this->n_nodes +=1;  //Il numero di nodi aumenta di 1
         this->n_tree +=1;   //Il numero di alberi aumenta di 1
 
-       
+        if(this->consolidate_budget > 0){   //in modalità incrementale X è una radice in attesa
+            this->n_pending += 1;
+            this->bound_pending();
+        }
+    }
+
+
+
+    /**
+     * @brief modalità di consolidazione incrementale.
+     * 
+     * Con budget 0 (default) extract_min consolida tutta la lista di radici.
+     * Con budget > 0 ogni operazione consolida al più budget radici: la tabella dei
+     * degree e il confine tra radici consolidate e in attesa restano tra una chiamata
+     * e l'altra. Le radici in attesa sono in testa alla lista e sono al più budget dopo
+     * ogni operazione, quindi la lista di radici resta corta (al più un albero per degree
+     * più le radici in attesa) e il nuovo minimo si trova scorrendola tutta.
+     * Il costo ammortizzato non cambia: il lavoro di consolidazione viene solo distribuito.
+     * 
+     * Il limite per operazione non vale per heap_union, split_roots e per questa stessa
+     * funzione: le radici che superano il budget vengono consolidate tutte in una volta,
+     * con un costo proporzionale al numero di radici aggiunte o rimaste (ad esempio O(n)
+     * per unire una Heap costruita con parallel_build, che ha n radici).
+     * 
+     * @param budget numero massimo di radici consolidate per operazione
+    */
+    void set_consolidate_budget(size_t budget){
+
+        this->consolidate_budget = budget;
+        this->degree_table.clear();
+        this->n_pending = 0;
 
+        if(budget > 0){
+            this->n_pending = this->n_tree;     //Tutte le radici vanno ancora consolidate
+            this->bound_pending();
+        }
     }
 
 
@@ -128,42 +194,65 @@ struct fibonacci_heap{
     * In particolare si aggiunge in coda alla lista di radici corrente quella nuova.
     * Il nodo di testa rimane dunque invariato ma si aggiornano se necessario il minimo,
     * il numero totale di nodi e degli alberi.
+    * In modalità incrementale le radici della heap unita diventano radici in attesa e
+    * quelle oltre il budget vengono consolidate subito: l'unione è esclusa dal limite
+    * per operazione e costa O(heap.n_tree) linking. Per latenze limitate conviene unire
+    * heap già consolidate, con poche radici.
     * 
     * @param heap Heap da unire
    */
    void heap_union (fibonacci_heap<T,CMP> heap ){
 
-    this->head->left->right = heap.head; //l'ultimo nodo della lista di radici
-                                            //della heap corrente (this) si lega a destra
-                                            //con la testa della heap da unire
+    if(heap.n_nodes == 0){      //niente da unire, se non le eventuali arene
+        this->arenas.insert(this->arenas.end(), heap.arenas.begin(), heap.arenas.end());
+        return;
+    }
+
+    if(this->n_nodes == 0){     //heap corrente vuota: la lista di radici è quella della heap da unire
+        this->head = heap.head;
+        this->min = heap.min;
+    }
 
-    heap.head->left->right = this->head;   //l'ultimo nodo della lista di radici della heap 
-                                            //da unire si lega a destra con il nodo di testa 
-                                            //della lista di radici della heap corrente(this)
+    else{
+        this->head->left->right = heap.head; //l'ultimo nodo della lista di radici
+                                                //della heap corrente (this) si lega a destra
+                                                //con la testa della heap da unire
+
+        heap.head->left->right = this->head;   //l'ultimo nodo della lista di radici della heap 
+                                                //da unire si lega a destra con il nodo di testa 
+                                                //della lista di radici della heap corrente(this)
     
-    Node<T>* temp = this->head->left;       //Copia temporanea dell'ultimo nodo della lista di 
-                                            //di radici della heap corrente(this)
+        Node<T>* temp = this->head->left;       //Copia temporanea dell'ultimo nodo della lista di 
+                                                //di radici della heap corrente(this)
 
-    this->head->left = heap.head->left;    //l'elemento di testa della lista di radici della heap 
-                                            //corrente(this) si lega a sinistra con  l'ultimo 
-                                            //elemento della lista della heap da unire
+        this->head->left = heap.head->left;    //l'elemento di testa della lista di radici della heap 
+                                                //corrente(this) si lega a sinistra con  l'ultimo 
+                                                //elemento della lista della heap da unire
    
-    heap.head->left->right = this->head;   //l'ultimo nodo della lista di radici della heap da 
-                                            //unire si leaga a destra con la testa della lista 
-                                            //di radici della heap corrente(this)
+        heap.head->left->right = this->head;   //l'ultimo nodo della lista di radici della heap da 
+                                                //unire si leaga a destra con la testa della lista 
+                                                //di radici della heap corrente(this)
 
-    heap.head->left = temp;                 //Il primo elemento della lista di radici della heap 
-                                            //da unire si lega a sinistra con la coda della lista
-                                            //della heap corrente(this)
+        heap.head->left = temp;                 //Il primo elemento della lista di radici della heap 
+                                                //da unire si lega a sinistra con la coda della lista
+                                                //della heap corrente(this)
 
-    if(cmp(this->min,heap.min)){  //Si aggiorna il nodo di minimo ne necessario
-        this->min = heap.min;
+        if(cmp(this->min,heap.min)){  //Si aggiorna il nodo di minimo ne necessario
+            this->min = heap.min;
+        }
     }
 
     this->n_nodes += heap.n_nodes; //Sommo il numero di nodi per avere il totale dell'unione
     this->n_tree += heap.n_tree; //Sommo analogamente il nuemero di alberi
 
-    
+    //Le arene della heap unita passano alla heap corrente
+    this->arenas.insert(this->arenas.end(), heap.arenas.begin(), heap.arenas.end());
+
+    if(this->consolidate_budget > 0){   //in modalità incrementale le nuove radici vanno in testa,
+        this->head = heap.head;         //tra quelle in attesa
+        this->n_pending += heap.n_tree;
+        this->bound_pending();
+    }
  
    }
 
@@ -233,8 +322,57 @@ struct fibonacci_heap{
      * @return valore minimo della Heap estratto
     */
     T extract_min(){
-         
-        
+
+        Node<T>* extracted = this->extract_min_node();
+        T min_value = extracted->key;
+        if(!extracted->pooled) delete extracted;   //libero la memoria del nodo estratto
+                                                   //(i nodi delle arene sono liberati da clear)
+        return min_value;
+    }
+
+
+
+    /**
+     * @brief sostituzione del minimo.
+     * 
+     * Equivale a extract_min seguita da insert di new_key, ma riusa il nodo minimo.
+     * Se new_key non è maggiore della chiave corrente il nodo resta il minimo e
+     * l'operazione costa O(1); altrimenti il nodo viene staccato e reinserito con la
+     * nuova chiave senza allocazioni, con lo stesso costo (consolidate compresa) di
+     * extract_min_node più insert_node.
+     * 
+     * @param new_key nuovo valore del nodo minimo
+    */
+    void replace_top(const T new_key){
+
+        if(this->n_nodes==0){
+            throw std::invalid_argument( "Can't replace min beacause the heap is empty");
+        }
+
+        Node<T> candidate(new_key);
+        if(!cmp(&candidate,this->min)){     //new_key non supera il minimo corrente:
+            this->min->key = new_key;       //l'ordine della Heap è rispettato
+            return;
+        }
+
+        Node<T>* top = this->extract_min_node();
+        top->key = new_key;
+        this->insert_node(top);
+    }
+
+
+
+    /**
+     * @brief estrazione del nodo minimo.
+     * 
+     * Come extract_min, ma il nodo non viene deallocato: viene restituito staccato
+     * dalla Heap (senza figli, genitore nè fratelli) così che possa essere riusato
+     * con insert_node. La deallocazione è a carico del chiamante, tranne per i nodi
+     * di un'arena (pooled), che restano di proprietà della Heap fino a clear.
+     * 
+     * @return nodo minimo estratto
+    */
+    Node<T>* extract_min_node(){
 
         if(this->n_nodes==0){
             throw std::invalid_argument( "Can't extract min beacause the heap is empty");   //Errore: viene lanciato se la fibonacci heap è vuota
@@ -243,14 +381,16 @@ struct fibonacci_heap{
 
         
 
+        if(this->consolidate_budget > 0) return this->extract_min_incremental();
+
+        Node<T>* extracted = this->min;     //nodo da restituire
+
         if(this->n_nodes==1){                 //caso particolare in cui la heap ha solo un nodo
-            T min_value = this->min->key;     //salvo in una nuova variabile il valore del minimo
-            delete this->min;                 //elimino il nodo 
             this->n_nodes=0;                  //aggiorno i valori della heap
             this->n_tree = 0;
             this->head = nullptr;
             this->min = nullptr;
-            return min_value;               //ritorna il minimo
+            return this->detach(extracted);   //ritorna il minimo
             
         }
 
@@ -258,11 +398,9 @@ struct fibonacci_heap{
         if(this->n_tree == 1){  
             
 
-            T min_value = this->min->key;
             this->n_tree = this->head->degree;  //I figli diventano radici
             this->n_nodes = this->n_nodes-1;
             this->head = this->head->child; //Aggiornamento della lista di radici
-            delete this->min;  //Libero la memoria
             this->min = this->head;
             
             
@@ -275,10 +413,7 @@ struct fibonacci_heap{
                 current = current->right;                   //Si passa al nodo successivo nella lista
             }         
 
-
-
-
-            return min_value;
+            return this->detach(extracted);
         }
 
 
@@ -289,8 +424,6 @@ struct fibonacci_heap{
                                             //della lista di radici
         }
 
-        T min_value = this->min->key; //Salvo il valore minimo in una nuova variabile
-
 
 
         //Se il nodo da rimuovere ha figli:
@@ -358,7 +491,6 @@ struct fibonacci_heap{
 
        
         this->n_nodes = this->n_nodes - 1 ;  //Il numero di nodi è calato di 1
-        delete this->min;   //elimino dalla memoria il nodo di minimo precedente
         
         this->consolidate();  //chiamo la funzione consolidate
         this->min = this->head;
@@ -370,9 +502,10 @@ struct fibonacci_heap{
             if(cmp(this->min,curr)) {                  
                 this->min = curr;   //aggiornamento del minimo
             }
+            curr = curr->right;     //Si passa alla radice successiva
         }    
 
-        return min_value;
+        return this->detach(extracted);
     }
 
 
@@ -390,10 +523,9 @@ struct fibonacci_heap{
 
         //Bisogna controllare che new_key < key per la relazione d'ordine del comparatore
 
-        Node<T>* confronto = new Node<T>;
-        confronto->key = new_key;
+        Node<T> confronto(new_key);     //nodo di appoggio per il confronto, sullo stack
 
-        if(cmp(confronto,x)){
+        if(cmp(&confronto,x)){
             std::cout<<"Inserito nuovo valore del nodo maggiore della chiave precedente, nessuna modifica apportata."<<std::endl;
         }
 
@@ -410,12 +542,416 @@ struct fibonacci_heap{
             if(cmp(this->min,x)){
                 this->min = x;
             }
+
+            if(this->consolidate_budget > 0) this->bound_pending();
+        }
+    }
+
+
+
+    /**
+     * @brief rimozione di un nodo.
+     * 
+     * Rimuove dalla Heap un nodo qualsiasi: lo si taglia portandolo nella lista di radici,
+     * come farebbe un decremento a meno infinito, e lo si estrae come minimo.
+     * Il nodo viene deallocato, se non appartiene a un'arena.
+     * 
+     * @param x nodo da rimuovere
+    */
+    void erase(Node<T>* x){
+
+        Node<T>* y = x->parent;
+        if(y != nullptr){
+            this->cut(x);
+            this->cascading_cut(y);
+        }
+
+        this->min = x;      //x è una radice: la si estrae come se fosse il minimo
+        Node<T>* extracted = this->extract_min_node();
+        if(!extracted->pooled) delete extracted;
+    }
+
+
+    /**
+     * @brief svuotamento della Heap.
+     * 
+     * Dealloca tutti i nodi della Heap senza passare da extract_min, visitando
+     * iterativamente ogni lista (radici e figli), e riporta la Heap allo stato vuoto.
+     * Le arene vengono liberate in blocco, compresi i nodi già estratti.
+    */
+    void clear(){
+
+        std::vector<Node<T>*> lists;    //teste delle liste circolari ancora da visitare
+        if(this->head != nullptr) lists.push_back(this->head);
+
+        while(!lists.empty()){
+            Node<T>* current = lists.back();
+            lists.pop_back();
+            current->left->right = nullptr;     //Si spezza la lista circolare per sapere dove finisce
+
+            while(current != nullptr){
+                Node<T>* next = current->right;
+                if(current->child != nullptr) lists.push_back(current->child);
+                if(!current->pooled) delete current;
+                current = next;
+            }
+        }
+
+        for(size_t i = 0; i < this->arenas.size(); ++i) delete[] this->arenas[i];
+        this->arenas.clear();
+
+        this->degree_table.clear();
+        this->n_pending = 0;
+        this->head = nullptr;
+        this->min = nullptr;
+        this->n_nodes = 0;
+        this->n_tree = 0;
+    }
+
+
+
+    /**
+     * @brief copia profonda della Heap.
+     * 
+     * La copia implicita della struct condivide i nodi; clone invece duplica l'intera
+     * foresta in O(n) con una sola allocazione (un'arena di n_nodes nodi), mantenendo
+     * struttura, ordine delle liste, degree e mark. In modalità incrementale anche la
+     * tabella dei degree e le radici in attesa vengono riportate sui nodi copiati.
+     * Le due Heap sono poi indipendenti.
+     * 
+     * @param handles se non nullptr, viene riempita con la corrispondenza
+     *                nodo originale -> nodo della copia
+     * @return Heap copiata
+    */
+    fibonacci_heap<T,CMP> clone(std::unordered_map<const Node<T>*, Node<T>*>* handles = nullptr) const{
+
+        fibonacci_heap<T,CMP> copy;
+        copy.cmp = this->cmp;
+        copy.consolidate_budget = this->consolidate_budget;
+        if(this->n_nodes == 0) return copy;
+
+        Node<T>* block = new Node<T>[this->n_nodes];    //unica allocazione per tutti i nodi
+        copy.arenas.push_back(block);
+        if(handles != nullptr) handles->reserve(handles->size() + this->n_nodes);
+
+        size_t next = 0;    //prossimo nodo libero del blocco
+
+        //Liste ancora da copiare: testa della lista originale e genitore nella copia
+        std::vector<std::pair<const Node<T>*, Node<T>*>> lists;
+        lists.push_back(std::make_pair(this->head, (Node<T>*)nullptr));
+
+        while(!lists.empty()){
+
+            const Node<T>* first = lists.back().first;
+            Node<T>* parent = lists.back().second;
+            lists.pop_back();
+
+            Node<T>* copy_first = &block[next];
+            Node<T>* prev = nullptr;
+            const Node<T>* current = first;
+
+            do{
+                Node<T>* c = &block[next++];
+                c->key = current->key;
+                c->degree = current->degree;
+                c->mark = current->mark;
+                c->pooled = true;
+                c->parent = parent;
+
+                if(prev != nullptr){    //collegamento con il fratello precedente
+                    prev->right = c;
+                    c->left = prev;
+                }
+                if(current->child != nullptr) lists.push_back(std::make_pair((const Node<T>*)current->child, c));
+                if(current == this->min) copy.min = c;
+                if(handles != nullptr) (*handles)[current] = c;
+
+                prev = c;
+                current = current->right;
+            }while(current != first);
+
+            prev->right = copy_first;   //chiusura della lista circolare
+            copy_first->left = prev;
+
+            if(parent != nullptr) parent->child = copy_first;
+            else copy.head = copy_first;
         }
-        delete confronto;  //libero la memoria
+
+        copy.n_nodes = this->n_nodes;
+        copy.n_tree = this->n_tree;
+
+        //La lista di radici è copiata per prima, quindi le radici occupano i primi n_tree
+        //nodi del blocco nello stesso ordine: la tabella dei degree si riporta sulle copie
+        copy.n_pending = this->n_pending;
+        copy.degree_table.assign(this->degree_table.size(), nullptr);
+        const Node<T>* root = this->head;
+        for(size_t i = 0; i < this->n_tree; ++i, root = root->right){
+            size_t deg = root->degree;
+            if(deg < this->degree_table.size() && this->degree_table[deg] == root) copy.degree_table[deg] = &block[i];
+        }
+
+        return copy;
+    }
+
+
+
+    /**
+     * @brief separazione di alberi.
+     * 
+     * Stacca dalla lista di radici fino a max_trees alberi interi, a partire dalla radice
+     * a destra del minimo, e li restituisce come una nuova Heap. Gli alberi sono già
+     * ordinati a heap, quindi non serve alcun linking: la lista staccata viene chiusa su
+     * sè stessa e basta contarne i nodi. Il minimo resta nella Heap corrente, a meno che
+     * sia l'unico albero: in quel caso viene staccata l'intera Heap.
+     * Le arene restano alla Heap corrente, che deve quindi vivere più a lungo dei nodi staccati.
+     * 
+     * @param max_trees numero massimo di alberi da staccare
+     * @return Heap con gli alberi staccati
+    */
+    fibonacci_heap<T,CMP> split_roots(size_t max_trees){
+
+        fibonacci_heap<T,CMP> part;
+        part.cmp = this->cmp;
+        if(this->n_nodes == 0 || max_trees == 0) return part;
+
+        if(this->n_tree == 1){      //un solo albero: passa tutto alla nuova Heap
+            part.head = this->head;
+            part.min = this->min;
+            part.n_nodes = this->n_nodes;
+            part.n_tree = 1;
+            this->head = nullptr;
+            this->min = nullptr;
+            this->n_nodes = 0;
+            this->n_tree = 0;
+            this->set_consolidate_budget(this->consolidate_budget);
+            return part;
+        }
+
+        size_t k = std::min(max_trees, this->n_tree - 1);
+        Node<T>* first = this->min->right;
+        Node<T>* last = first;
+        part.min = first;
+        bool head_taken = false;
+
+        for(size_t i = 0; i < k; ++i){
+            if(i > 0) last = last->right;
+            if(last == this->head) head_taken = true;
+            if(part.cmp(part.min, last)) part.min = last;
+            part.n_nodes += this->count_nodes(last);
+        }
+
+        //Gli alberi [first, last] escono dalla lista di radici corrente
+        this->min->right = last->right;
+        last->right->left = this->min;
+        if(head_taken) this->head = this->min;
+
+        //e formano una lista circolare a sè
+        first->left = last;
+        last->right = first;
+
+        part.head = first;
+        part.n_tree = k;
+        this->n_tree -= k;
+        this->n_nodes -= part.n_nodes;
+        this->set_consolidate_budget(this->consolidate_budget);    //in modalità incrementale si ricostruisce la tabella
+
+        return part;
     }
 
 
 private:
+
+    /**
+     * @brief distacco di un nodo.
+     * 
+     * Azzera i collegamenti e lo stato di un nodo appena rimosso dalla Heap.
+     * 
+     * @param x nodo da staccare
+     * @return lo stesso nodo x
+    */
+    Node<T>* detach(Node<T>* x){
+        x->child = nullptr;
+        x->parent = nullptr;
+        x->left = x;
+        x->right = x;
+        x->degree = 0;
+        x->mark = false;
+        return x;
+    }
+
+    /**
+     * @brief inserimento di una lista in testa.
+     * 
+     * Aggiunge una lista circolare di radici davanti alla testa della lista di radici,
+     * che diventa la sua testa. Non aggiorna i contatori.
+     * 
+     * @param list testa della lista circolare da aggiungere
+    */
+    void splice_front(Node<T>* list){
+
+        if(this->head == nullptr){
+            this->head = list;
+            return;
+        }
+
+        Node<T>* list_tail = list->left;
+        Node<T>* tail = this->head->left;
+
+        tail->right = list;
+        list->left = tail;
+        list_tail->right = this->head;
+        this->head->left = list_tail;
+        this->head = list;
+    }
+
+    /**
+     * @brief passo di consolidazione incrementale.
+     * 
+     * Consolida al più max_roots radici in attesa, prendendole dalla testa della lista.
+     * La radice presa esce dal gruppo in attesa spostando la testa alla sua destra
+     * (nella lista circolare finisce così in coda, tra le radici consolidate); poi viene
+     * unita alle radici della tabella con lo stesso degree finchè trova un posto libero.
+     * Il minimo non perde mai un linking, quindi min resta valido.
+     * 
+     * @param max_roots numero massimo di radici da consolidare
+    */
+    void consolidate_step(size_t max_roots){
+
+        for(size_t i = 0; i < max_roots && this->n_pending > 0; ++i){
+
+            Node<T>* carry = this->head;
+            this->head = this->head->right;
+            this->n_pending -= 1;
+
+            while(true){
+                size_t deg = carry->degree;
+                if(deg >= this->degree_table.size()) this->degree_table.resize(deg + 1, nullptr);
+
+                Node<T>* other = this->degree_table[deg];
+                if(other == nullptr){
+                    this->degree_table[deg] = carry;
+                    break;
+                }
+
+                this->degree_table[deg] = nullptr;
+                if(other == this->min || (carry != this->min && cmp(carry,other))){
+                    std::swap(carry, other);    //carry è sempre la radice che resta
+                }
+                this->linking(carry, other);
+            }
+        }
+    }
+
+    /**
+     * @brief limite sulle radici in attesa.
+     * 
+     * Consolida quanto basta perchè le radici in attesa non superino il budget.
+    */
+    void bound_pending(){
+        if(this->n_pending > this->consolidate_budget){
+            this->consolidate_step(this->n_pending - this->consolidate_budget);
+        }
+    }
+
+    /**
+     * @brief estrazione minimo in modalità incrementale.
+     * 
+     * Il minimo viene tolto dalla lista (e dalla tabella dei degree se consolidato),
+     * i suoi figli diventano radici in attesa in testa alla lista e si consolidano al più
+     * budget radici. Il budget effettivo non scende sotto log_phi(n)+1, così che le radici
+     * in attesa non crescano da un'estrazione all'altra. Il nuovo minimo si cerca
+     * sull'intera lista di radici, che resta corta.
+     * 
+     * @return nodo minimo estratto
+    */
+    Node<T>* extract_min_incremental(){
+
+        Node<T>* extracted = this->min;
+        size_t deg = extracted->degree;
+
+        if(deg < this->degree_table.size() && this->degree_table[deg] == extracted){
+            this->degree_table[deg] = nullptr;      //era una radice consolidata
+        }
+        else{
+            this->n_pending -= 1;                   //era una radice in attesa
+        }
+
+        //Rimozione del minimo dalla lista di radici
+        if(extracted->right == extracted){
+            this->head = nullptr;
+        }
+        else{
+            if(this->head == extracted) this->head = extracted->right;
+            extracted->left->right = extracted->right;
+            extracted->right->left = extracted->left;
+        }
+        this->n_tree -= 1;
+
+        //I figli diventano radici in attesa
+        if(extracted->child != nullptr){
+            Node<T>* current = extracted->child;
+            for(int i = 0; i < extracted->degree; ++i){
+                current->parent = nullptr;
+                current = current->right;
+            }
+            this->splice_front(extracted->child);
+            this->n_tree += extracted->degree;
+            this->n_pending += extracted->degree;
+        }
+
+        this->n_nodes -= 1;
+
+        size_t budget = std::max(this->consolidate_budget, this->max_degree() + 1);
+        this->consolidate_step(budget);
+        this->bound_pending();
+
+        //Ricerca del nuovo minimo sulla lista di radici
+        this->min = this->head;
+        Node<T>* current = this->head;
+        for(size_t i = 0; i < this->n_tree; ++i){
+            if(cmp(this->min,current)) this->min = current;
+            current = current->right;
+        }
+
+        return this->detach(extracted);
+    }
+
+    /**
+     * @brief conteggio dei nodi di un albero.
+     * @param root radice dell'albero
+     * @return numero di nodi dell'albero, radice compresa
+    */
+    size_t count_nodes(const Node<T>* root) const{
+
+        size_t count = 0;
+        std::vector<const Node<T>*> stack(1, root);
+
+        while(!stack.empty()){
+            const Node<T>* x = stack.back();
+            stack.pop_back();
+            count += 1;
+
+            const Node<T>* child = x->child;
+            for(int i = 0; i < x->degree; ++i){
+                stack.push_back(child);
+                child = child->right;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief limite sul degree.
+     * 
+     * In una Heap di Fibonacci con n nodi il degree massimo è al più log_phi(n),
+     * con phi la sezione aurea.
+     * 
+     * @return stima del degree massimo raggiungibile con n_nodes nodi
+    */
+    size_t max_degree() const{
+        if(this->n_nodes < 2) return 1;
+        return (size_t)(std::log((double)this->n_nodes) / std::log(1.618033988749895)) + 1;
+    }
  
   /**
    * @brief funzione di linking.
@@ -537,16 +1073,13 @@ private:
     */
     void consolidate(){
 
-        Node<T>* A[n_nodes];  // Array che associa ad ogni posizione una radice con relativo degree.
-                                     //Dunque in posizione 0 punta alla radice con degree 0, in posizione x alla
-                                     //radice di degree x
-                                     //Viene allocata una dimensione di n_nodes perchè sicuramente maggiore del
-                                     //max degree raggiungibile
-
-        for(int j = 0; j<= n_nodes; ++j){    //Ogni elemento di A è inizializzato nullptr
-            A[j]=nullptr;        
-            
-        }    
+        // Array che associa ad ogni posizione una radice con relativo degree.
+        //Dunque in posizione 0 punta alla radice con degree 0, in posizione x alla
+        //radice di degree x.
+        //La dimensione iniziale è il limite logaritmico sul degree massimo (log_phi(n_nodes)),
+        //non n_nodes: così la consolidazione non costa O(n) e non usa lo stack per heap grandi.
+        //Se un degree dovesse superarla l'array viene esteso.
+        std::vector<Node<T>*> A(max_degree() + 1, nullptr);
         
 
         int iter = n_tree;      //Salvo il numero di alberi presenti nella heap prima di iniziare le operazioni di "consolidate"
@@ -561,6 +1094,7 @@ private:
 
             
             int deg = current->degree; //Per comodità salvo la variabile deg
+            if(deg + 1 >= (int)A.size()) A.resize(deg + 2, nullptr);
 
             
             
@@ -603,6 +1137,8 @@ private:
                          }
                     
                    
+                    if(current->degree + 1 >= (int)A.size()) A.resize(current->degree + 2, nullptr);
+
                     if(A[current->degree]==nullptr){    //Se la posizione nell'array A è libera
                         
                         A[current->degree] = current;   //aggiornamento dell'array A
@@ -621,7 +1157,8 @@ private:
      /**
       * @brief funzione di taglio.
       * 
-      * Prende un nodo, lo rimuove dalla posizione corrente e lo aggiunge alla lista di radici.
+      * Prende un nodo, lo rimuove dalla lista di figli del genitore e lo aggiunge,
+      * insieme al suo sottoalbero, in testa alla lista di radici.
       * 
       * @param x puntatore al nodo da tagliare
      */
@@ -631,90 +1168,61 @@ private:
             std::cout<<"Il nodo "<<x->key<<" è già nella lista di radici"<<std::endl;;
         }
         else{   
-            if(x->degree == 0){     //Se il nodo x non ha figli
-            //Aggiungo x in testa alla lista di radici
-
-                if(x->parent->degree == 1){ //sottocaso in cui x è "figlio unico"
-                    x->right = this->head;
-                    x->left = this->head->left;
-                    this->head->left->right = x;
-                    this->head->left = x;
-                    this->head = x;
-                    x->parent->degree =0;
-                    x->parent->child = nullptr;
-                    x->parent = nullptr;
-                    this->n_tree = this->n_tree + 1;    
-                }
-                else{ //sottocaso in cui x NON è "figlio unico"
-
-                    if(x->parent->child == x){       //Se x è la testa della lista di figli,
-                        x->parent->child = x->right; //la testa diventa il nodo alla sua destra
-                    }
-
-                    //Sposto x in testa alla lista di radici
-
-                    x->left->right = x->right; 
-                    x->right->left = x->left;
+            Node<T>* y = x->parent;
 
-                    x->right = this->head;
-                    x->left = this->head->left;
-                    this->head->left->right = x;
-                    this->head->left = x;
-                
-                    this->head = x;    
-                    x->parent->degree = x->parent->degree - 1;
-                    x->parent = nullptr;
-                    this->n_tree = this->n_tree + 1;                
-                }
+            if(x->right == x){               //sottocaso in cui x è "figlio unico"
+                y->child = nullptr;
             }
-            else{  //Caso in cui il nodo x ha figli
-
-
-                if(x->parent->degree == 1){ //sottocaso in cui x è "figlio unico"
-                    x->parent->child = x->child; 
-                    x->child = nullptr;
-                    x->parent->degree = x->degree;
-                    x->degree = 0;
-                    x->right = this->head;
-                    x->left = this->head->left;
-                    this->head->left->right = x;
-                    this->head->left = x;
-                    this->head = x;
-                    this->n_tree = this->n_tree + 1;
-
+            else{                            //sottocaso in cui x NON è "figlio unico"
+                if(y->child == x){           //Se x è la testa della lista di figli,
+                    y->child = x->right;     //la testa diventa il nodo alla sua destra
                 }
+                x->left->right = x->right; 
+                x->right->left = x->left;
+            }
+            y->degree = y->degree - 1;
+
+            //Sposto x, con i suoi figli, in testa alla lista di radici
+            x->left = x;
+            x->right = x;
+            x->parent = nullptr;
+            x->mark = 0;
+            this->splice_front(x);
+            this->n_tree = this->n_tree + 1;
+
+            if(this->consolidate_budget > 0){
+                this->n_pending += 1;           //x è una nuova radice in attesa
+                if(y->parent == nullptr) this->unindex_root(y, y->degree + 1);
+            }
 
-                else{ //sottocaso in cui x NON è figlio unico
-
-                    if(x->parent->child == x){       //Se x è la testa della lista di figli,
-                        x->parent->child = x->right; //la testa diventa il nodo alla sua destra
-                    }
-
-                    x->left->right = x->child;
-                    x->right->left = x->child->left;
-                    x->child->left->right = x->right;
-                    x->child->left = x->left;
-
-                    x->parent->degree = x->parent->degree + x->degree - 1;
-                    x->degree = 0;
-                    x->child = nullptr;
-                    x->right = this->head;
-                    x->left = this->head->left;
-                    this->head->left->right = x;
-                    this->head->left = x;
-                    
-                    this->head = x;
-                    this->n_tree = this->n_tree + 1;
+            if(cmp(this->min,x)) this->min = x;  //aggiornamento del minimo (non necessario se non fosse per la decrease function)
 
-                }
+        }
+    }
 
-            }
+    /**
+     * @brief radice consolidata modificata.
+     * 
+     * In modalità incrementale, se una radice consolidata perde un figlio il suo degree
+     * non corrisponde più alla posizione nella tabella: la si toglie dalla tabella e la si
+     * sposta in testa tra le radici in attesa.
+     * 
+     * @param y radice il cui degree è cambiato
+     * @param old_degree degree di y prima della modifica
+    */
+    void unindex_root(Node<T>* y, size_t old_degree){
 
+        if(old_degree >= this->degree_table.size() || this->degree_table[old_degree] != y) return;   //y era già in attesa
 
-            if(x->mark == 1) x->mark = 0;
-            if(cmp(this->min,x)) this->min = x;  //aggiornamento del minimo (non necessario se non fosse per la decrease function)
+        this->degree_table[old_degree] = nullptr;
 
-        }
+        if(this->head == y) this->head = y->right;
+        y->left->right = y->right;
+        y->right->left = y->left;
+        y->left = y;
+        y->right = y;
+        this->splice_front(y);
+        this->n_pending += 1;
     }
 
     /**
@@ -722,13 +1230,14 @@ private:
      * @param y puntatore al nodo cui applicare la funzione
     */
     void cascading_cut(Node<T>* y){
-        if(y->parent != nullptr){  
+        Node<T>* z = y->parent;
+        if(z != nullptr){  
             //Se y non è una radice   
 
             if(y->mark==0) y->mark = 1;  //Se non è marcato aggiorno mark 
             else{                        //altrimenti
                 this->cut(y);            //si taglia y e si richiama la funzione
-                cascading_cut(y->parent);//sul genitore di y
+                cascading_cut(z);        //sul genitore di y (salvato prima del taglio)
 
             }
         }
@@ -0,0 +1,139 @@
+#ifndef __indexedheap_hpp__
+#define __indexedheap_hpp__
+
+
+#include "fibonacciheap.hpp"
+#include <vector>
+#include <utility>
+
+/**
+ * @brief Coda di priorità indicizzata da ID interi.
+ *
+ * Gli elementi sono identificati da un ID denso in [0, capacity). Ogni ID ha il suo
+ * nodo in un array allocato alla costruzione, quindi il passaggio da ID a nodo è un
+ * accesso all'array e quello da nodo a ID una differenza di puntatori: non servono
+ * mappe nè allocazioni durante l'uso. I nodi sono marcati pooled, così la Heap non
+ * prova mai a liberarli.
+ *
+ * @tparam T tipo delle chiavi
+ * @tparam CMP classe del comparatore (lo stesso della fibonacci_heap)
+*/
+template<typename T,typename CMP>
+struct indexed_fibonacci_heap{
+
+    fibonacci_heap<T,CMP> heap; /**< Heap dei nodi degli ID presenti */
+    std::vector<Node<T>> nodes; /**< nodo di ogni ID, in posizione pari all'ID */
+    std::vector<bool> present; /**< vale 1 se l'ID è nella Heap */
+
+
+    /**
+     * @brief costruttore.
+     * @param capacity numero di ID gestiti (gli ID validi sono 0 ... capacity-1)
+    */
+    indexed_fibonacci_heap(size_t capacity)
+        : nodes(capacity), present(capacity, false)
+    {
+        for(size_t i = 0; i < capacity; ++i) this->nodes[i].pooled = true;
+    }
+
+    indexed_fibonacci_heap(const indexed_fibonacci_heap&) = delete;
+    indexed_fibonacci_heap& operator=(const indexed_fibonacci_heap&) = delete;
+
+
+    /**
+     * @brief numero di elementi.
+     * @return numero di ID presenti nella Heap
+    */
+    size_t size() const{
+        return this->heap.n_nodes;
+    }
+
+
+    /**
+     * @brief presenza di un ID.
+     * @param id ID da cercare
+     * @return true se l'ID è nella Heap
+    */
+    bool contains(size_t id) const{
+        return id < this->present.size() && this->present[id];
+    }
+
+
+    /**
+     * @brief chiave di un ID.
+     * @param id ID presente nella Heap
+     * @return chiave corrente dell'ID
+    */
+    const T& key_of(size_t id) const{
+        if(!this->contains(id)) throw std::invalid_argument("Can't read key because the id is not in the heap");
+        return this->nodes[id].key;
+    }
+
+
+    /**
+     * @brief inserimento o decremento.
+     *
+     * Se l'ID non è presente lo inserisce con la chiave data; se è presente e la chiave
+     * data precede quella corrente ne decrementa la chiave; altrimenti non fa nulla.
+     *
+     * @param id ID dell'elemento
+     * @param key chiave proposta
+     * @return true se l'ID è stato inserito o la sua chiave decrementata
+    */
+    bool push_or_decrease(size_t id, const T key){
+
+        this->check_id(id);
+        Node<T>* x = &this->nodes[id];
+
+        if(!this->present[id]){
+            x->key = key;
+            this->heap.insert_node(x);
+            this->present[id] = true;
+            return true;
+        }
+
+        Node<T> candidate(key);
+        if(!this->heap.cmp(x, &candidate)) return false;    //key non precede la chiave corrente
+
+        this->heap.decrease_key(x, key);
+        return true;
+    }
+
+
+    /**
+     * @brief rimozione di un ID.
+     * @param id ID presente nella Heap
+    */
+    void erase(size_t id){
+        if(!this->contains(id)) throw std::invalid_argument("Can't erase because the id is not in the heap");
+        this->heap.erase(&this->nodes[id]);
+        this->present[id] = false;
+    }
+
+
+    /**
+     * @brief estrazione del minimo.
+     * @return coppia (ID, chiave) dell'elemento minimo estratto
+    */
+    std::pair<size_t,T> pop(){
+
+        Node<T>* x = this->heap.extract_min_node();
+        size_t id = x - &this->nodes[0];
+        this->present[id] = false;
+        return std::make_pair(id, x->key);
+    }
+
+
+private:
+
+    /**
+     * @brief controllo dell'ID.
+     * @param id ID da controllare
+    */
+    void check_id(size_t id) const{
+        if(id >= this->nodes.size()) throw std::out_of_range("id out of range");
+    }
+
+};
+
+#endif  //__indexedheap_hpp__
@@ -0,0 +1,173 @@
+#ifndef __kwaymerge_hpp__
+#define __kwaymerge_hpp__
+
+
+#include "fibonacciheap.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief Cursore su una sequenza ordinata in memoria.
+ *
+ * Legge a blocchi gli elementi compresi tra due iteratori.
+ *
+ * @tparam It tipo dell'iteratore
+*/
+template<typename It>
+struct range_cursor{
+
+    typedef typename std::iterator_traits<It>::value_type value_type;
+
+    It first; /**< prossimo elemento da leggere */
+    It last; /**< fine della sequenza */
+
+    range_cursor(It begin, It end)
+        : first(begin), last(end)
+        {}
+
+    /**
+     * @brief lettura di un blocco.
+     * @param out buffer in cui copiare gli elementi
+     * @param max numero massimo di elementi da leggere
+     * @return numero di elementi letti (0 se la sequenza è finita)
+    */
+    size_t read(value_type* out, size_t max){
+        size_t count = 0;
+        while(count < max && this->first != this->last){
+            out[count] = *this->first;
+            ++this->first;
+            ++count;
+        }
+        return count;
+    }
+
+};
+
+
+
+
+/**
+ * @brief Cursore su un file binario ordinato.
+ *
+ * Il file contiene una sequenza di valori di tipo T scritti con fwrite; viene letto
+ * sequenzialmente a blocchi con fread.
+ *
+ * @tparam T tipo degli elementi (banalmente copiabile)
+*/
+template<typename T>
+struct file_cursor{
+
+    static_assert(std::is_trivially_copyable<T>::value, "file_cursor richiede elementi banalmente copiabili");
+
+    typedef T value_type;
+
+    std::FILE* file; /**< file aperto in lettura */
+
+    file_cursor(const std::string& path)
+        : file(std::fopen(path.c_str(), "rb"))
+    {
+        if(this->file == nullptr) throw std::runtime_error("Can't open run file " + path);
+    }
+
+    file_cursor(file_cursor&& other) noexcept
+        : file(other.file)
+    {
+        other.file = nullptr;
+    }
+
+    file_cursor(const file_cursor&) = delete;
+    file_cursor& operator=(const file_cursor&) = delete;
+
+    ~file_cursor(){
+        if(this->file != nullptr) std::fclose(this->file);
+    }
+
+    /**
+     * @brief lettura di un blocco.
+     * @param out buffer in cui copiare gli elementi
+     * @param max numero massimo di elementi da leggere
+     * @return numero di elementi letti (0 se il file è finito)
+    */
+    size_t read(T* out, size_t max){
+        size_t count = std::fread(out, sizeof(T), max, this->file);
+        if(count < max && std::ferror(this->file)) throw std::runtime_error("Can't read run file");
+        return count;
+    }
+
+};
+
+
+
+
+/**
+ * @brief Fusione a k vie di sequenze ordinate.
+ *
+ * Una fibonacci_heap contiene un nodo per ogni cursore, con chiave pari all'elemento
+ * di testa del cursore. I nodi sono allocati tutti insieme in un array, così il cursore
+ * di un nodo si ricava dalla sua posizione nell'array senza mappe ausiliarie.
+ * Dopo aver scritto il minimo, la testa successiva dello stesso cursore lo sostituisce
+ * con replace_top invece di extract_min più insert; ogni cursore viene letto a blocchi
+ * di batch elementi. La nuova testa di un run ordinato è quasi sempre maggiore, quindi
+ * replace_top costa come extract_min più insert: si risparmiano solo le allocazioni.
+ *
+ * @tparam CMP classe del comparatore sui nodi di tipo Node<Cursor::value_type>
+ * @tparam Cursor tipo dei cursori (con value_type e read(value_type*, size_t))
+ * @tparam OutputIt tipo dell'iteratore di output
+ * @param cursors cursori da fondere, ciascuno su una sequenza ordinata secondo CMP
+ * @param out iteratore su cui scrivere la sequenza fusa
+ * @param batch numero di elementi letti da un cursore per ogni lettura
+ * @return iteratore di output dopo l'ultimo elemento scritto
+*/
+template<typename CMP,typename Cursor,typename OutputIt>
+OutputIt kway_merge(std::vector<Cursor>& cursors, OutputIt out, size_t batch = 1024){
+
+    typedef typename Cursor::value_type T;
+
+    if(batch == 0) throw std::invalid_argument("kway_merge batch size must be positive");
+
+    size_t k = cursors.size();
+    std::vector<Node<T>> nodes(k);          //un nodo per cursore, riusato per tutta la fusione
+    std::vector<T> buffers(k * batch);      //buffer di lettura, batch elementi per cursore
+    std::vector<size_t> pos(k, 0);          //prossimo elemento da usare nel buffer di ogni cursore
+    std::vector<size_t> len(k, 0);          //elementi validi nel buffer di ogni cursore
+
+    fibonacci_heap<T,CMP> heap;
+
+    for(size_t i = 0; i < k; ++i){
+        len[i] = cursors[i].read(&buffers[i * batch], batch);
+        if(len[i] > 0){
+            nodes[i].key = buffers[i * batch];
+            pos[i] = 1;
+            heap.insert_node(&nodes[i]);
+        }
+    }
+
+    while(heap.n_nodes > 0){
+
+        Node<T>* top = heap.min;
+        size_t i = top - &nodes[0];     //cursore da cui proviene il minimo
+
+        *out = top->key;
+        ++out;
+
+        if(pos[i] == len[i]){           //buffer esaurito: si legge il blocco successivo
+            len[i] = cursors[i].read(&buffers[i * batch], batch);
+            pos[i] = 0;
+        }
+
+        if(len[i] == 0){
+            heap.extract_min_node();    //cursore finito: il nodo resta nell'array
+        }
+        else{
+            heap.replace_top(buffers[i * batch + pos[i]]);
+            pos[i] += 1;
+        }
+    }
+
+    return out;
+}
+
+#endif  //__kwaymerge_hpp__
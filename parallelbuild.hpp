@@ -0,0 +1,140 @@
+#ifndef __parallelbuild_hpp__
+#define __parallelbuild_hpp__
+
+
+#include "fibonacciheap.hpp"
+#include <thread>
+#include <exception>
+#include <iterator>
+#include <vector>
+
+/**
+ * @brief Attesa dei thread all'uscita dallo scope.
+ *
+ * Se la creazione di un thread lancia un'eccezione, i thread già avviati vengono
+ * attesi prima che il vettore li distrugga (distruggere un thread ancora joinable
+ * chiama std::terminate).
+*/
+struct thread_join_guard{
+
+    std::vector<std::thread>& threads; /**< thread da attendere */
+
+    thread_join_guard(std::vector<std::thread>& t)
+        : threads(t)
+        {}
+
+    ~thread_join_guard(){
+        this->join();
+    }
+
+    /**
+     * @brief attesa di tutti i thread ancora joinable.
+    */
+    void join(){
+        for(size_t i = 0; i < this->threads.size(); ++i){
+            if(this->threads[i].joinable()) this->threads[i].join();
+        }
+    }
+
+};
+
+
+
+
+/**
+ * @brief Costruzione parallela di una Heap.
+ *
+ * L'input viene diviso in parti contigue, una per thread. Ogni thread alloca la propria
+ * arena di nodi, vi copia le chiavi della sua parte, le collega in una lista di radici
+ * e ne calcola il minimo locale. Le sotto-heap vengono poi unite con heap_union, che
+ * collega le liste di radici in O(1) e confronta i minimi locali: il minimo globale è
+ * quindi una riduzione su un valore per thread.
+ *
+ * Come ogni nodo di un'arena, i nodi restano allocati fino a clear anche dopo essere
+ * stati estratti.
+ *
+ * @tparam T tipo delle chiavi
+ * @tparam CMP classe del comparatore
+ * @tparam It tipo dell'iteratore (ad accesso casuale)
+ * @param first inizio dell'input
+ * @param last fine dell'input
+ * @param threads numero di thread (0 per usare quelli disponibili)
+ * @return Heap contenente tutte le chiavi dell'input
+*/
+template<typename T,typename CMP,typename It>
+fibonacci_heap<T,CMP> parallel_build(It first, It last, unsigned threads = 0){
+
+    size_t n = std::distance(first, last);
+
+    if(threads == 0) threads = std::thread::hardware_concurrency();
+    if(threads == 0) threads = 1;
+    if(threads > n) threads = n > 0 ? (unsigned)n : 1;
+
+    std::vector<fibonacci_heap<T,CMP>> parts(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);       //push_back non rialloca, quindi non lancia dopo aver creato un thread
+    thread_join_guard guard(workers);
+
+    try{
+        for(unsigned t = 0; t < threads; ++t){
+
+            size_t begin = n * t / threads;     //parte [begin, end) dell'input
+            size_t end = n * (t + 1) / threads;
+
+            workers.push_back(std::thread([&parts, &errors, first, begin, end, t](){
+                try{
+                    size_t count = end - begin;
+                    if(count == 0) return;
+
+                    fibonacci_heap<T,CMP>& part = parts[t];
+                    part.arenas.reserve(1);                 //push_back non lancia dopo l'allocazione dell'arena
+                    Node<T>* block = new Node<T>[count];   //arena del thread
+                    part.arenas.push_back(block);
+
+                    It input = first;
+                    std::advance(input, begin);
+
+                    Node<T>* min = &block[0];
+                    for(size_t i = 0; i < count; ++i, ++input){
+                        Node<T>* x = &block[i];
+                        x->key = *input;
+                        x->pooled = true;
+                        x->left = &block[i == 0 ? count - 1 : i - 1];     //lista circolare di radici
+                        x->right = &block[i == count - 1 ? 0 : i + 1];
+                        if(part.cmp(min, x)) min = x;      //minimo locale
+                    }
+
+                    part.head = &block[0];
+                    part.min = min;
+                    part.n_nodes = count;
+                    part.n_tree = count;
+                }
+                catch(...){
+                    errors[t] = std::current_exception();
+                }
+            }));
+        }
+    }
+    catch(...){     //creazione di un thread fallita: si attendono quelli avviati e se ne liberano le arene
+        guard.join();
+        for(unsigned u = 0; u < threads; ++u) parts[u].clear();
+        throw;
+    }
+
+    guard.join();
+
+    for(unsigned t = 0; t < threads; ++t){
+        if(errors[t]){      //si liberano le arene già costruite e si rilancia l'errore
+            for(unsigned u = 0; u < threads; ++u) parts[u].clear();
+            std::rethrow_exception(errors[t]);
+        }
+    }
+
+    fibonacci_heap<T,CMP> heap;
+    for(unsigned t = 0; t < threads; ++t) heap.heap_union(parts[t]);     //unione in O(1) per sotto-heap
+
+    return heap;
+}
+
+#endif  //__parallelbuild_hpp__
@@ -0,0 +1,279 @@
+#ifndef __scheduler_hpp__
+#define __scheduler_hpp__
+
+
+#include "fibonacciheap.hpp"
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Task con priorità.
+*/
+struct scheduled_task{
+
+    long priority; /**< priorità del task (valori più piccoli vengono eseguiti prima) */
+    std::function<void()> run; /**< funzione da eseguire */
+
+};
+
+
+/**
+ * @brief Comparatore dei task.
+ *
+ * Ordina i nodi per priorità crescente, come NodeComparator per le chiavi.
+*/
+struct task_comparator{
+    bool operator()(const Node<scheduled_task>* n1,const Node<scheduled_task>* n2){
+        return (n1->key.priority > n2->key.priority);
+    }
+};
+
+
+
+
+/**
+ * @brief Worker dello scheduler.
+ *
+ * Ogni worker possiede una fibonacci_heap di task protetta da un proprio mutex.
+*/
+struct scheduler_worker{
+
+    std::mutex lock; /**< protegge tasks */
+    fibonacci_heap<scheduled_task,task_comparator> tasks; /**< task in attesa del worker */
+    size_t n_executed; /**< task eseguiti dal worker */
+    size_t n_steals; /**< furti riusciti dal worker */
+    size_t n_stolen_tasks; /**< task ottenuti con i furti */
+
+    scheduler_worker()
+        : n_executed(0), n_steals(0), n_stolen_tasks(0)
+        {}
+
+};
+
+
+
+
+/**
+ * @brief Scheduler a priorità con work stealing.
+ *
+ * Non c'è una coda globale: ogni worker esegue il minimo della propria Heap. Un worker
+ * senza task ruba a un altro worker metà degli alberi della sua lista di radici con
+ * split_roots e li unisce alla propria Heap con heap_union. Gli alberi sono già ordinati
+ * a heap, quindi un solo furto sposta molti task senza confronti nè linking.
+ * L'ordine di esecuzione rispetta le priorità solo localmente a ogni worker.
+ *
+ * I task inviati da un worker finiscono nella sua Heap, quelli inviati da fuori vengono
+ * distribuiti a turno tra i worker.
+*/
+struct task_scheduler{
+
+    std::vector<std::unique_ptr<scheduler_worker>> workers; /**< worker, uno per thread */
+    std::vector<std::thread> threads; /**< thread dei worker */
+
+    std::mutex idle_lock; /**< protegge le attese su wake e done */
+    std::condition_variable wake; /**< sveglia i worker quando arrivano task */
+    std::condition_variable done; /**< segnala a wait() che tutti i task sono terminati */
+
+    std::atomic<size_t> n_ready; /**< task presenti nelle Heap, non ancora presi da un worker */
+    std::atomic<size_t> n_unfinished; /**< task inviati e non ancora terminati */
+    std::atomic<size_t> next_worker; /**< worker a cui inviare il prossimo task esterno */
+    std::atomic<bool> stopping; /**< vale 1 quando i worker devono terminare */
+
+
+    /**
+     * @brief costruttore.
+     *
+     * Avvia i thread dei worker.
+     *
+     * @param n_workers numero di worker (0 per usare i thread disponibili)
+    */
+    task_scheduler(unsigned n_workers = 0)
+        : n_ready(0), n_unfinished(0), next_worker(0), stopping(false)
+    {
+        if(n_workers == 0) n_workers = std::thread::hardware_concurrency();
+        if(n_workers == 0) n_workers = 1;
+
+        for(unsigned i = 0; i < n_workers; ++i) this->workers.emplace_back(new scheduler_worker);
+        for(unsigned i = 0; i < n_workers; ++i) this->threads.emplace_back(&task_scheduler::worker_loop, this, i);
+    }
+
+    task_scheduler(const task_scheduler&) = delete;
+    task_scheduler& operator=(const task_scheduler&) = delete;
+
+    /**
+     * @brief distruttore.
+     *
+     * Attende la fine di tutti i task e termina i thread.
+    */
+    ~task_scheduler(){
+
+        this->wait();
+        {
+            std::lock_guard<std::mutex> guard(this->idle_lock);
+            this->stopping = true;
+        }
+        this->wake.notify_all();
+        for(size_t i = 0; i < this->threads.size(); ++i) this->threads[i].join();
+        for(size_t i = 0; i < this->workers.size(); ++i) this->workers[i]->tasks.clear();
+    }
+
+
+    /**
+     * @brief invio di un task.
+     * @param priority priorità del task (valori più piccoli prima)
+     * @param run funzione da eseguire
+    */
+    void submit(long priority, std::function<void()> run){
+
+        int self = this->current_worker();
+        size_t target = self >= 0 ? (size_t)self : this->next_worker.fetch_add(1) % this->workers.size();
+
+        scheduled_task task;
+        task.priority = priority;
+        task.run = std::move(run);
+
+        this->n_unfinished += 1;
+        this->n_ready += 1;
+        {
+            std::lock_guard<std::mutex> guard(this->workers[target]->lock);
+            this->workers[target]->tasks.insert(task);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(this->idle_lock);     //evita che un worker perda la notifica
+        }
+        this->wake.notify_one();
+    }
+
+
+    /**
+     * @brief attesa.
+     *
+     * Blocca il chiamante finchè tutti i task inviati, compresi quelli inviati dai task
+     * stessi, sono terminati.
+    */
+    void wait(){
+        std::unique_lock<std::mutex> guard(this->idle_lock);
+        this->done.wait(guard, [this]{ return this->n_unfinished == 0; });
+    }
+
+
+private:
+
+    /**
+     * @brief worker del thread corrente.
+     * @return indice del worker se il chiamante è un thread di questo scheduler, -1 altrimenti
+    */
+    int current_worker() const{
+        return current_owner() == this ? current_index() : -1;
+    }
+
+    static const task_scheduler*& current_owner(){
+        static thread_local const task_scheduler* owner = nullptr;
+        return owner;
+    }
+
+    static int& current_index(){
+        static thread_local int index = -1;
+        return index;
+    }
+
+
+    /**
+     * @brief estrazione di un task locale.
+     * @param self indice del worker
+     * @param task task estratto
+     * @return true se la Heap del worker non era vuota
+    */
+    bool pop_local(size_t self, scheduled_task& task){
+
+        scheduler_worker& w = *this->workers[self];
+        std::lock_guard<std::mutex> guard(w.lock);
+        if(w.tasks.n_nodes == 0) return false;
+
+        Node<scheduled_task>* x = w.tasks.extract_min_node();
+        task = std::move(x->key);
+        delete x;
+        this->n_ready -= 1;
+        return true;
+    }
+
+
+    /**
+     * @brief furto.
+     *
+     * Prova i worker a partire dal successivo e stacca metà degli alberi della prima
+     * Heap non vuota, unendoli alla Heap del worker self.
+     *
+     * @param self indice del worker che ruba
+     * @return true se il furto è riuscito
+    */
+    bool steal(size_t self){
+
+        size_t n = this->workers.size();
+
+        for(size_t i = 1; i < n; ++i){
+
+            scheduler_worker& victim = *this->workers[(self + i) % n];
+            fibonacci_heap<scheduled_task,task_comparator> loot;
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if(victim.tasks.n_nodes == 0) continue;
+                loot = victim.tasks.split_roots((victim.tasks.n_tree + 1) / 2);
+            }
+
+            scheduler_worker& w = *this->workers[self];
+            std::lock_guard<std::mutex> guard(w.lock);
+            w.n_steals += 1;
+            w.n_stolen_tasks += loot.n_nodes;
+            w.tasks.heap_union(loot);
+            return true;
+        }
+        return false;
+    }
+
+
+    /**
+     * @brief ciclo di un worker.
+     *
+     * Esegue il minimo locale; se la Heap è vuota ruba, e se non c'è nulla da rubare
+     * attende nuovi task.
+     *
+     * @param self indice del worker
+    */
+    void worker_loop(size_t self){
+
+        current_owner() = this;
+        current_index() = (int)self;
+
+        scheduled_task task;
+
+        while(true){
+
+            if(this->pop_local(self, task) || (this->steal(self) && this->pop_local(self, task))){
+
+                task.run();
+                task.run = nullptr;
+                this->workers[self]->n_executed += 1;
+
+                if(--this->n_unfinished == 0){
+                    std::lock_guard<std::mutex> guard(this->idle_lock);
+                    this->done.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> guard(this->idle_lock);
+            this->wake.wait(guard, [this]{ return this->stopping || this->n_ready > 0; });
+            if(this->stopping && this->n_ready == 0) return;
+        }
+    }
+
+};
+
+#endif  //__scheduler_hpp__
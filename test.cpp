@@ -1,4 +1,11 @@
 #include "fibonacciheap.hpp"
+#include "externalheap.hpp"
+#include "topkheap.hpp"
+#include "kwaymerge.hpp"
+#include "indexedheap.hpp"
+#include "parallelbuild.hpp"
+#include "scheduler.hpp"
+#include "aggregatingheap.hpp"
 
 
 //Comparatore per le key dei nodi
@@ -123,6 +130,143 @@ catch(const std::exception& e){
 
 
 
+//Coda di priorità in memoria esterna: con un budget di 4 KiB la Heap in memoria
+//tiene poche decine di nodi e le chiavi più grandi vengono scritte su disco
+external_fibonacci_heap<int,NodeComparator<int>> E(4096, 256);
+
+for(int i = 0; i < 1000; ++i){
+    E.insert((i * 7919) % 1000);
+}
+
+std::cout<<"Heap esterna: primi valori estratti ";
+for(int i = 0; i < 5; ++i){
+    std::cout<<E.extract_min()<<" ";
+}
+std::cout<<std::endl;
+std::cout<<"Run scritti: "<<E.n_spills<<", byte scritti: "<<E.bytes_written
+         <<", byte letti: "<<E.bytes_read<<std::endl;
+
+
+//Selezione dei 3 valori più piccoli di uno stream: la memoria resta di 3 nodi
+topk_heap<int,NodeComparator<int>> K(3);
+
+for(int i = 0; i < 1000; ++i){
+    K.insert((i * 7919) % 1000);
+}
+
+std::cout<<"Top-3: ";
+std::vector<int> best = K.drain_sorted();
+for(size_t i = 0; i < best.size(); ++i){
+    std::cout<<best[i]<<" ";
+}
+std::cout<<"(rifiutati "<<K.n_rejected<<" su "<<K.n_seen<<")"<<std::endl;
+
+
+//Fusione a k vie di tre sequenze ordinate
+std::vector<int> r1 = {1, 4, 7}, r2 = {2, 5, 8}, r3 = {3, 6, 9};
+std::vector<range_cursor<std::vector<int>::iterator>> cursors;
+cursors.push_back(range_cursor<std::vector<int>::iterator>(r1.begin(), r1.end()));
+cursors.push_back(range_cursor<std::vector<int>::iterator>(r2.begin(), r2.end()));
+cursors.push_back(range_cursor<std::vector<int>::iterator>(r3.begin(), r3.end()));
+
+std::vector<int> merged;
+kway_merge<NodeComparator<int>>(cursors, std::back_inserter(merged), 2);
+
+std::cout<<"Fusione: ";
+for(size_t i = 0; i < merged.size(); ++i){
+    std::cout<<merged[i]<<" ";
+}
+std::cout<<std::endl;
+
+
+//Copia profonda di una Heap: la copia ha nodi propri, allocati in un unico blocco
+fibonacci_heap<int,NodeComparator<int>> P;
+P.insert(5);
+P.insert(3);
+P.insert(8);
+P.insert(1);
+P.extract_min();    //consolida la foresta: la copia ne mantiene la struttura
+
+std::unordered_map<const Node<int>*, Node<int>*> handles;
+fibonacci_heap<int,NodeComparator<int>> Q = P.clone(&handles);
+
+Q.decrease_key(handles[P.min], 0);  //il nodo della copia corrispondente al minimo di P
+std::cout<<"Minimo dell'originale: "<<P.min->key<<", minimo della copia: "<<Q.min->key<<std::endl;
+
+P.clear();
+Q.clear();
+
+
+//Consolidazione incrementale: ogni operazione consolida al più 16 radici,
+//così un'estrazione dopo molti inserimenti non deve consolidarle tutte insieme
+fibonacci_heap<int,NodeComparator<int>> I;
+I.set_consolidate_budget(16);
+
+for(int i = 0; i < 1000; ++i){
+    I.insert((i * 7919) % 1000);
+}
+
+std::cout<<"Consolidazione incrementale: radici "<<I.n_tree<<", estratti ";
+for(int i = 0; i < 3; ++i){
+    std::cout<<I.extract_min()<<" ";
+}
+std::cout<<std::endl;
+I.clear();
+
+
+//Coda di priorità indicizzata: gli elementi sono identificati da ID interi
+indexed_fibonacci_heap<int,NodeComparator<int>> X(10);
+X.push_or_decrease(3, 40);
+X.push_or_decrease(7, 25);
+X.push_or_decrease(1, 30);
+X.push_or_decrease(3, 10);  //l'ID 3 è già presente: la sua chiave scende a 10
+X.push_or_decrease(7, 50);  //50 non precede 25: nessuna modifica
+X.erase(1);
+
+std::cout<<"Heap indicizzata: ";
+while(X.size() > 0){
+    std::pair<size_t,int> top = X.pop();
+    std::cout<<"(id "<<top.first<<", chiave "<<top.second<<") ";
+}
+std::cout<<std::endl;
+
+
+//Costruzione parallela di una Heap da un vettore, con 2 thread
+std::vector<int> input;
+for(int i = 0; i < 1000; ++i){
+    input.push_back((i * 7919) % 1000);
+}
+
+fibonacci_heap<int,NodeComparator<int>> B = parallel_build<int,NodeComparator<int>>(input.begin(), input.end(), 2);
+std::cout<<"Costruzione parallela: "<<B.n_nodes<<" nodi, minimo "<<B.min->key<<std::endl;
+B.clear();
+
+
+//Scheduler a priorità con work stealing: ogni worker ha la sua Heap di task
+std::atomic<int> completed(0);
+{
+    task_scheduler S(2);
+    for(int i = 0; i < 100; ++i){
+        S.submit(i % 10, [&completed]{ completed += 1; });
+    }
+    S.wait();
+}
+std::cout<<"Scheduler: task completati "<<completed<<std::endl;
+
+
+//Heap con aggregazione: 1000 elementi con solo 5 priorità distinte occupano 5 nodi
+aggregating_fibonacci_heap<int,int,NodeComparator<int>> G;
+for(int i = 0; i < 1000; ++i){
+    G.insert(i % 5, i);     //chiave: priorità, payload: indice dell'elemento
+}
+
+std::cout<<"Heap con aggregazione: "<<G.size()<<" elementi, "<<G.n_keys()<<" nodi, estratti ";
+for(int i = 0; i < 3; ++i){
+    std::pair<int,int> e = G.extract_min();
+    std::cout<<"("<<e.first<<", "<<e.second<<") ";
+}
+std::cout<<std::endl;
+
 
 return 0;
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef __topkheap_hpp__
+#define __topkheap_hpp__
+
+
+#include "fibonacciheap.hpp"
+#include <vector>
+#include <algorithm>
+
+/**
+ * @brief Comparatore inverso.
+ *
+ * Inverte l'ordine di un comparatore di nodi: la radice minima della Heap
+ * diventa quella che per CMP è la massima.
+ *
+ * @tparam T tipo delle chiavi dei nodi
+ * @tparam CMP classe del comparatore da invertire
+*/
+template<typename T,typename CMP>
+struct reverse_comparator{
+
+    CMP cmp; /**< comparatore originale */
+
+    bool operator()(const Node<T>* n1,const Node<T>* n2){
+        return cmp(n2,n1);
+    }
+
+};
+
+
+
+
+/**
+ * @brief Selezione dei k migliori elementi di uno stream.
+ *
+ * Conserva al più k chiavi, le k minime secondo CMP, in una fibonacci_heap ordinata
+ * al contrario: la sua radice minima è il peggiore elemento trattenuto.
+ * Un nuovo elemento non migliore del peggiore viene rifiutato in O(1) con un solo
+ * confronto; altrimenti il nodo del peggiore viene estratto e riusato per la nuova
+ * chiave, quindi a regime non si fanno allocazioni e la memoria resta proporzionale a k.
+ *
+ * @tparam T tipo delle chiavi
+ * @tparam CMP classe del comparatore (lo stesso della fibonacci_heap)
+*/
+template<typename T,typename CMP>
+struct topk_heap{
+
+    fibonacci_heap<T,reverse_comparator<T,CMP>> heap; /**< Heap degli elementi trattenuti, con il peggiore come minimo */
+    size_t k; /**< numero massimo di elementi trattenuti */
+    size_t n_seen; /**< numero di elementi proposti */
+    size_t n_rejected; /**< numero di elementi rifiutati senza modificare la Heap */
+
+
+    /**
+     * @brief costruttore.
+     * @param capacity numero k di elementi da trattenere
+    */
+    topk_heap(size_t capacity)
+        : k(capacity), n_seen(0), n_rejected(0)
+    {
+        if(capacity == 0) throw std::invalid_argument("top-k capacity must be positive");
+    }
+
+    topk_heap(const topk_heap&) = delete;
+    topk_heap& operator=(const topk_heap&) = delete;
+
+    /**
+     * @brief distruttore.
+    */
+    ~topk_heap(){
+        this->heap.clear();
+    }
+
+
+    /**
+     * @brief numero di elementi trattenuti.
+     * @return numero di elementi attualmente nella Heap (al più k)
+    */
+    size_t size() const{
+        return this->heap.n_nodes;
+    }
+
+
+    /**
+     * @brief peggiore elemento trattenuto.
+     * @return chiave che verrebbe scartata per prima
+    */
+    const T& worst() const{
+        if(this->heap.n_nodes == 0) throw std::invalid_argument("Can't read worst element because the heap is empty");
+        return this->heap.min->key;
+    }
+
+
+    /**
+     * @brief Funzione di inserimento.
+     *
+     * Finché gli elementi sono meno di k l'elemento viene sempre inserito; poi viene
+     * ammesso solo se migliore del peggiore, di cui prende il posto riusandone il nodo.
+     *
+     * @param x valore proposto
+     * @return true se x è stato trattenuto, false se rifiutato
+    */
+    bool insert(const T x){
+
+        this->n_seen += 1;
+
+        if(this->heap.n_nodes < this->k){
+            this->heap.insert(x);
+            return true;
+        }
+
+        Node<T> candidate(x);
+        if(!this->heap.cmp.cmp(this->heap.min, &candidate)){   //x non precede il peggiore: rifiuto in O(1)
+            this->n_rejected += 1;
+            return false;
+        }
+
+        Node<T>* evicted = this->heap.extract_min_node();   //il nodo del peggiore viene riusato
+        evicted->key = x;
+        this->heap.insert_node(evicted);
+        return true;
+    }
+
+
+    /**
+     * @brief svuotamento ordinato.
+     *
+     * Estrae tutti gli elementi trattenuti e li restituisce dal migliore al peggiore.
+     * Al termine la struttura è vuota e può essere riusata.
+     *
+     * @return elementi trattenuti in ordine secondo CMP
+    */
+    std::vector<T> drain_sorted(){
+
+        std::vector<T> sorted;
+        sorted.reserve(this->heap.n_nodes);
+        while(this->heap.n_nodes > 0) sorted.push_back(this->heap.extract_min());   //dal peggiore al migliore
+
+        std::reverse(sorted.begin(), sorted.end());
+        return sorted;
+    }
+
+};
+
+#endif  //__topkheap_hpp__